@@ -15,7 +15,7 @@ register_item{ name = "Armor Plate", type = 103, category = 1, max_count = 5, co
   on_use = function() api.add_plate(1) end }
 
 -- Simple bullet projectile def
-register_projectile{ name = "base_bullet", type = 1, speed = 28, size_x = 0.12, size_y = 0.12, physics_steps = 2,
+register_projectile{ name = "base_bullet", type = 1, speed = 28, size_x = 0.12, size_y = 0.12,
   on_hit_entity = function() end,
   on_hit_tile = function() end }
 
@@ -0,0 +1,222 @@
+#include "atlas.hpp"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+
+namespace {
+
+// Bottom-left skyline: the packed area's top edge as runs of (x, y, w);
+// each rect goes where its bottom lands lowest, ties to the narrower run.
+struct Skyline {
+    struct Node {
+        int x, y, w;
+    };
+    int w{0};
+    int h{0};
+    std::vector<Node> nodes;
+
+    void reset(int W, int H) {
+        w = W;
+        h = H;
+        nodes.assign(1, Node{0, 0, W});
+    }
+
+    // Top y for a rw x rh rect whose left edge is at node i, or -1.
+    int fit(std::size_t i, int rw, int rh) const {
+        if (nodes[i].x + rw > w) return -1;
+        int y = nodes[i].y, left = rw;
+        for (std::size_t j = i; left > 0; ++j) {
+            if (j >= nodes.size()) return -1;
+            y = std::max(y, nodes[j].y);
+            if (y + rh > h) return -1;
+            left -= nodes[j].w;
+        }
+        return y;
+    }
+
+    bool insert(int rw, int rh, SDL_Point& out) {
+        int best_bottom = INT_MAX, best_w = INT_MAX;
+        std::size_t best = nodes.size();
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            int y = fit(i, rw, rh);
+            if (y < 0) continue;
+            if (y + rh < best_bottom || (y + rh == best_bottom && nodes[i].w < best_w)) {
+                best_bottom = y + rh;
+                best_w = nodes[i].w;
+                best = i;
+                out = SDL_Point{nodes[i].x, y};
+            }
+        }
+        if (best == nodes.size()) return false;
+        nodes.insert(nodes.begin() + static_cast<std::ptrdiff_t>(best), Node{out.x, out.y + rh, rw});
+        // Trim the runs the new one now covers
+        const int right = out.x + rw;
+        for (std::size_t j = best + 1; j < nodes.size();) {
+            if (nodes[j].x >= right) break;
+            int cut = right - nodes[j].x;
+            nodes[j].x += cut;
+            nodes[j].w -= cut;
+            if (nodes[j].w > 0) break;
+            nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(j));
+        }
+        for (std::size_t j = 0; j + 1 < nodes.size();) {
+            if (nodes[j].y == nodes[j + 1].y) {
+                nodes[j].w += nodes[j + 1].w;
+                nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(j + 1));
+            } else {
+                ++j;
+            }
+        }
+        return true;
+    }
+
+    int used_height() const {
+        int m = 0;
+        for (const Node& n : nodes) m = std::max(m, n.y);
+        return m;
+    }
+};
+
+void evict(TextureAtlas& a, AtlasPage& p) {
+    SDL_DestroyTexture(p.tex);
+    p.tex = nullptr;
+    a.resident -= p.bytes();
+    a.evictions += 1;
+}
+
+// Least recently used first; pages drawn this frame stay (queued batches
+// still point at them), so the budget can be overrun for a frame.
+void make_room(TextureAtlas& a, std::size_t need) {
+    while (a.resident + need > a.budget) {
+        AtlasPage* victim = nullptr;
+        for (AtlasPage& p : a.pages)
+            if (p.tex && p.last_used < a.frame && (!victim || p.last_used < victim->last_used)) victim = &p;
+        if (!victim) return;
+        evict(a, *victim);
+    }
+}
+
+bool build_page(TextureAtlas& a, SDL_Renderer* r, AtlasPage& p) {
+    make_room(a, p.bytes());
+    SDL_Surface* surf = SDL_CreateRGBSurfaceWithFormat(0, p.w, p.h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surf) {
+        std::fprintf(stderr, "[gfx] atlas page surface failed: %s\n", SDL_GetError());
+        p.failed = true;
+        return false;
+    }
+    for (int id : p.sprites) {
+        const auto k = static_cast<std::size_t>(id);
+        SDL_Surface* img = IMG_Load(a.paths[k].c_str());
+        if (!img) {
+            std::fprintf(stderr, "IMG_Load failed for %s: %s\n", a.paths[k].c_str(), IMG_GetError());
+            continue;
+        }
+        // Copy, not blend; clip to the packed size in case the file changed
+        SDL_SetSurfaceBlendMode(img, SDL_BLENDMODE_NONE);
+        SDL_Rect dst = a.regions[k].src;
+        SDL_Rect src{0, 0, dst.w, dst.h};
+        SDL_BlitSurface(img, &src, surf, &dst);
+        SDL_FreeSurface(img);
+    }
+    p.tex = SDL_CreateTextureFromSurface(r, surf);
+    SDL_FreeSurface(surf);
+    if (!p.tex) {
+        std::fprintf(stderr, "[gfx] atlas page texture failed: %s\n", SDL_GetError());
+        p.failed = true;
+        return false;
+    }
+    SDL_SetTextureBlendMode(p.tex, SDL_BLENDMODE_BLEND);
+    a.resident += p.bytes();
+    a.page_loads += 1;
+    return true;
+}
+
+} // namespace
+
+void atlas_build(TextureAtlas& a, const std::vector<std::string>& paths) {
+    atlas_clear(a);
+    a.paths = paths;
+    a.regions.assign(paths.size(), AtlasRegion{});
+    struct Item {
+        int id, w, h;
+    };
+    std::vector<Item> items;
+    for (std::size_t id = 0; id < paths.size(); ++id) {
+        if (paths[id].empty()) continue;
+        SDL_Surface* s = IMG_Load(paths[id].c_str());
+        if (!s) {
+            std::fprintf(stderr, "IMG_Load failed for %s: %s\n", paths[id].c_str(), IMG_GetError());
+            continue;
+        }
+        items.push_back(Item{static_cast<int>(id), s->w, s->h});
+        SDL_FreeSurface(s);
+    }
+    // Tallest first keeps the skyline flat
+    std::sort(items.begin(), items.end(), [](const Item& x, const Item& y) {
+        if (x.h != y.h) return x.h > y.h;
+        if (x.w != y.w) return x.w > y.w;
+        return x.id < y.id;
+    });
+    Skyline sky;
+    int open = -1;
+    auto close_open = [&]() {
+        if (open >= 0) a.pages[static_cast<std::size_t>(open)].h = std::max(1, sky.used_height());
+    };
+    for (const Item& it : items) {
+        const int pw = it.w + TextureAtlas::PAD, ph = it.h + TextureAtlas::PAD;
+        AtlasRegion& reg = a.regions[static_cast<std::size_t>(it.id)];
+        if (pw > TextureAtlas::PAGE || ph > TextureAtlas::PAGE) {
+            AtlasPage own{};
+            own.w = it.w;
+            own.h = it.h;
+            own.sprites.push_back(it.id);
+            a.pages.push_back(std::move(own));
+            reg = AtlasRegion{static_cast<int>(a.pages.size() - 1), SDL_Rect{0, 0, it.w, it.h}};
+            continue;
+        }
+        SDL_Point at{0, 0};
+        if (open < 0 || !sky.insert(pw, ph, at)) {
+            close_open();
+            AtlasPage page{};
+            page.w = page.h = TextureAtlas::PAGE;
+            a.pages.push_back(std::move(page));
+            open = static_cast<int>(a.pages.size() - 1);
+            sky.reset(TextureAtlas::PAGE, TextureAtlas::PAGE);
+            sky.insert(pw, ph, at);
+        }
+        reg = AtlasRegion{open, SDL_Rect{at.x, at.y, it.w, it.h}};
+        a.pages[static_cast<std::size_t>(open)].sprites.push_back(it.id);
+    }
+    close_open();
+    std::size_t total = 0;
+    for (const AtlasPage& p : a.pages) total += p.bytes();
+    std::printf("[gfx] atlas: %zu images on %zu pages (%.1f MB if all resident, budget %.1f MB)\n", items.size(),
+                a.pages.size(), static_cast<double>(total) / (1024.0 * 1024.0),
+                static_cast<double>(a.budget) / (1024.0 * 1024.0));
+}
+
+SpriteTex atlas_get(TextureAtlas& a, SDL_Renderer* r, int sprite_id) {
+    if (sprite_id < 0 || static_cast<std::size_t>(sprite_id) >= a.regions.size()) return SpriteTex{};
+    const AtlasRegion& reg = a.regions[static_cast<std::size_t>(sprite_id)];
+    if (reg.page < 0) return SpriteTex{};
+    AtlasPage& p = a.pages[static_cast<std::size_t>(reg.page)];
+    if (!p.tex && (p.failed || !r || !build_page(a, r, p))) return SpriteTex{};
+    p.last_used = a.frame;
+    const float iw = 1.0f / static_cast<float>(p.w), ih = 1.0f / static_cast<float>(p.h);
+    return SpriteTex{p.tex, reg.src,
+                     SDL_FRect{static_cast<float>(reg.src.x) * iw, static_cast<float>(reg.src.y) * ih,
+                               static_cast<float>(reg.src.w) * iw, static_cast<float>(reg.src.h) * ih}};
+}
+
+void atlas_end_frame(TextureAtlas& a) { a.frame += 1; }
+
+void atlas_clear(TextureAtlas& a) {
+    for (AtlasPage& p : a.pages)
+        if (p.tex) SDL_DestroyTexture(p.tex);
+    a.pages.clear();
+    a.regions.clear();
+    a.paths.clear();
+    a.resident = 0;
+}
@@ -0,0 +1,58 @@
+// Texture atlas.
+// Responsibility: pack sprite images into a few large pages at load (skyline
+// packer), build a page's texture on first use, and evict least recently used
+// pages to stay within a VRAM budget.
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct AtlasRegion {
+    int page{-1}; // -1 => image missing
+    SDL_Rect src{};
+};
+
+struct AtlasPage {
+    int w{0};
+    int h{0};
+    std::vector<int> sprites; // ids packed here
+    SDL_Texture* tex{nullptr}; // nullptr => not resident
+    std::uint64_t last_used{0}; // frame
+    bool failed{false};         // building it failed once; not retried
+    std::size_t bytes() const { return static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4; }
+};
+
+// A sprite as drawn: its page texture and where on it.
+struct SpriteTex {
+    SDL_Texture* tex{nullptr};
+    SDL_Rect src{};
+    SDL_FRect uv{}; // src normalized to the page
+    explicit operator bool() const { return tex != nullptr; }
+};
+
+struct TextureAtlas {
+    static constexpr int PAGE = 2048; // larger images get a page of their own
+    static constexpr int PAD = 1;
+    std::vector<AtlasPage> pages;
+    std::vector<AtlasRegion> regions; // index == sprite id
+    std::vector<std::string> paths;   // index == sprite id, as packed
+    std::size_t budget{256u << 20};   // resident page bytes
+    std::size_t resident{0};
+    std::uint64_t frame{1};
+    std::uint64_t page_loads{0};
+    std::uint64_t evictions{0};
+};
+
+// Replace the packing with `paths` (index == sprite id; empty => no image).
+// Reads each image once for its size; no textures are made here.
+void atlas_build(TextureAtlas& a, const std::vector<std::string>& paths);
+// Makes the page resident (evicting if over budget); empty if the image is
+// missing or its page could not be built.
+SpriteTex atlas_get(TextureAtlas& a, SDL_Renderer* r, int sprite_id);
+// Pages used in the current frame are never evicted; call once per frame.
+void atlas_end_frame(TextureAtlas& a);
+// Destroy all page textures and forget the packing.
+void atlas_clear(TextureAtlas& a);
@@ -15,9 +15,11 @@ bool init_audio() {
 
 void cleanup_audio() {
     if (!aa) return;
-    for (auto& kv : aa->chunks)
-        Mix_FreeChunk(kv.second);
+    for (Mix_Chunk* ch : aa->chunks)
+        Mix_FreeChunk(ch);
     aa->chunks.clear();
+    aa->names.clear();
+    aa->sound_ids.clear();
     if (Mix_QuerySpec(nullptr, nullptr, nullptr))
         Mix_CloseAudio();
     delete aa;
@@ -26,21 +28,50 @@ void cleanup_audio() {
 
 bool load_sound(const std::string& key, const std::string& path) {
     if (!aa) return false;
+    std::optional<Sym> sym = intern(key);
+    if (!sym) return false;
     Mix_Chunk* ch = Mix_LoadWAV(path.c_str());
     if (!ch)
         return false;
-    aa->chunks[key] = ch;
+    auto [it, added] = aa->sound_ids.emplace(*sym, static_cast<int>(aa->chunks.size()));
+    if (added) {
+        aa->chunks.push_back(ch);
+        aa->names.push_back(key);
+    } else {
+        // Reloading a key keeps its id
+        Mix_FreeChunk(aa->chunks[static_cast<std::size_t>(it->second)]);
+        aa->chunks[static_cast<std::size_t>(it->second)] = ch;
+    }
     return true;
 }
 
-void play_sound(const std::string& key, int loops, int channel, int volume) {
-    if (!aa) return;
-    auto it = aa->chunks.find(key);
-    if (it == aa->chunks.end())
+int try_get_sound_id(std::string_view key) {
+    return try_get_sound_id(sym_key(key));
+}
+
+int try_get_sound_id(SymKey key) {
+    if (!aa) return -1;
+    auto it = aa->sound_ids.find(key.sym);
+    if (it == aa->sound_ids.end()) return -1;
+    // An unloaded key can still hash to a loaded one's id
+    return aa->names[static_cast<std::size_t>(it->second)] == key.name ? it->second : -1;
+}
+
+void play_sound(SymKey key, int loops, int channel, int volume) {
+    play_sound(try_get_sound_id(key), loops, channel, volume);
+}
+
+void play_sound(std::string_view key, int loops, int channel, int volume) {
+    play_sound(try_get_sound_id(key), loops, channel, volume);
+}
+
+void play_sound(int sound_id, int loops, int channel, int volume) {
+    if (!aa || sound_id < 0 || static_cast<std::size_t>(sound_id) >= aa->chunks.size())
         return;
+    Mix_Chunk* ch = aa->chunks[static_cast<std::size_t>(sound_id)];
     if (volume >= 0)
-        Mix_VolumeChunk(it->second, volume);
-    Mix_PlayChannel(channel, it->second, loops);
+        Mix_VolumeChunk(ch, volume);
+    Mix_PlayChannel(channel, ch, loops);
 }
 
 void load_mod_sounds(const std::string& mods_root) {
@@ -4,11 +4,17 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+
+#include "symbols.hpp"
 
 // Struct-only audio store; functions operate on it.
 struct Audio {
-    std::unordered_map<std::string, Mix_Chunk*> chunks;
+    std::unordered_map<Sym, int> sound_ids;
+    std::vector<Mix_Chunk*> chunks; // index == sound id
+    std::vector<std::string> names; // index == sound id
 };
 
 // Initialize SDL_mixer and allocate the global Audio instance.
@@ -17,11 +23,20 @@ bool init_audio();
 // Free all loaded chunks, shutdown SDL_mixer, and destroy the global instance.
 void cleanup_audio();
 
-// Load a sound file (.wav/.ogg) into the global store with a key.
+// Load a sound file (.wav/.ogg) into the global store with a key. False if
+// the file fails to load or the key's id is held by another key.
 bool load_sound(const std::string& key, const std::string& path);
 
+// Sound id for a loaded key, or -1. Ids stay valid until cleanup_audio.
+int try_get_sound_id(std::string_view key);
+int try_get_sound_id(SymKey key);
+
 // Play a sound by key from the global store. Optional loops/channel/volume.
-void play_sound(const std::string& key, int loops = 0, int channel = -1, int volume = -1);
+// Engine sounds pass a literal symbol ("base:reload"_sym): no hashing at runtime.
+void play_sound(SymKey key, int loops = 0, int channel = -1, int volume = -1);
+void play_sound(std::string_view key, int loops = 0, int channel = -1, int volume = -1);
+// Same, by id; skips the key lookup. -1 is a no-op.
+void play_sound(int sound_id, int loops = 0, int channel = -1, int volume = -1);
 
 // Scan mods/*/sounds for audio assets and load into global store.
 void load_mod_sounds(const std::string& mods_root = "mods");
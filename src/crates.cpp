@@ -16,7 +16,12 @@ void update_crates_open() {
     glm::vec2 ph = p->half_size();
     float pl = p->pos.x - ph.x, pr = p->pos.x + ph.x;
     float pt = p->pos.y - ph.y, pb = p->pos.y + ph.y;
-    for (auto& c : ss->crates.data()) if (c.active && !c.opened) {
+    // Back to front: opening releases the crate slot mid-walk
+    auto slots = ss->crates.active_slots();
+    for (std::size_t k = slots.size(); k-- > 0;) {
+        std::size_t slot = slots[k];
+        auto& c = ss->crates.data()[slot];
+        if (c.opened) continue;
         glm::vec2 ch = c.size * 0.5f;
         float cl = c.pos.x - ch.x, cr = c.pos.x + ch.x;
         float ct = c.pos.y - ch.y, cb = c.pos.y + ch.y;
@@ -26,11 +31,13 @@ void update_crates_open() {
         if (overlap) c.open_progress = std::min(open_time, c.open_progress + TIMESTEP);
         else c.open_progress = std::max(0.0f, c.open_progress - TIMESTEP * 0.5f);
         if (c.open_progress >= open_time) {
-            c.opened = true; c.active = false; ss->metrics.crates_opened += 1;
-            glm::vec2 pos = c.pos;
+            // Copy what the drop needs; `c` must not be read once the slot is released
+            const glm::vec2 pos = c.pos;
+            const int def_type = c.def_type;
+            c.opened = true; ss->crates.release(slot); ss->metrics.crates_opened += 1;
             if (luam) {
                 DropTables dt{}; bool have = false;
-                if (auto const* cd = luam->find_crate(c.def_type)) { dt = cd->drops; have = true; }
+                if (auto const* cd = luam->find_crate(def_type)) { dt = cd->drops; have = true; }
                 if (!have) dt = luam->drops();
                 static thread_local std::mt19937 rng{std::random_device{}()};
                 std::uniform_real_distribution<float> U(0.0f, 1.0f);
@@ -48,8 +55,7 @@ void update_crates_open() {
                 if (cval < 0.6f && !dt.items.empty()) {
                     int t = pick_weighted(dt.items);
                     if (t >= 0) {
-                        auto it = std::find_if(luam->items().begin(), luam->items().end(), [&](const ItemDef& d) { return d.type == t; });
-                        if (it != luam->items().end()) {
+                        if (const ItemDef* it = luam->find_item(t)) {
                             if (auto iv = ss->items.spawn_from_def(*it, 1)) {
                                 ss->ground_items.spawn(*iv, pos);
                                 ss->metrics.items_spawned += 1;
@@ -59,19 +65,16 @@ void update_crates_open() {
                 } else if (!dt.guns.empty()) {
                     int t = pick_weighted(dt.guns);
                     if (t >= 0) {
-                        auto ig = std::find_if(luam->guns().begin(), luam->guns().end(), [&](const GunDef& g) { return g.type == t; });
-                        if (ig != luam->guns().end()) {
+                        if (const GunDef* ig = luam->find_gun(t)) {
                             if (auto gv = ss->guns.spawn_from_def(*ig)) {
-                                int sid = -1;
-                                if (!ig->sprite.empty() && ig->sprite.find(':') != std::string::npos)
-                                    sid = try_get_sprite_id(ig->sprite);
+                                int sid = ig->sprite_id;
                                 ss->ground_guns.spawn(*gv, pos, sid);
                                 ss->metrics.guns_spawned += 1;
                             }
                         }
                     }
                 }
-                if (ss->player_vid) if (auto* plent = ss->entities.get_mut(*ss->player_vid)) luam->call_crate_on_open(c.def_type, *plent);
+                if (ss->player_vid) if (auto* plent = ss->entities.get_mut(*ss->player_vid)) luam->call_crate_on_open(def_type, *plent);
             }
         }
     }
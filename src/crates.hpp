@@ -2,8 +2,9 @@
 // Responsibility: simple crate entity storage and shared-sized defaults.
 #pragma once
 
+#include "pool.hpp"
+
 #include <glm/glm.hpp>
-#include <vector>
 #include <cstddef>
 
 // Simple crate entity pooled in State
@@ -17,30 +18,19 @@ struct Crate {
     float open_progress{0.0f};
 };
 
-struct CratesPool {
+struct CratesPool : public Pool<Crate, 512> {
   public:
     static constexpr std::size_t MAX = 512;
-    CratesPool() { items.resize(MAX); }
     Crate* spawn(glm::vec2 p, int type) {
-        for (auto& c : items) {
-            if (!c.active) {
-                c.active = true;
-                c.opened = false;
-                c.def_type = type;
-                c.pos = p;
-                c.size = {0.5f, 0.2f};
-                c.open_progress = 0.0f;
-                return &c;
-            }
-        }
-        return nullptr;
+        auto v = alloc();
+        if (!v)
+            return nullptr;
+        Crate* c = get(*v);
+        c->def_type = type;
+        c->pos = p;
+        c->size = {0.5f, 0.2f};
+        return c;
     }
-    void clear() { for (auto& c : items) c.active = false; }
-    std::vector<Crate>& data() { return items; }
-    const std::vector<Crate>& data() const { return items; }
-
-  private:
-    std::vector<Crate> items;
 };
 
 // Wrapper for the crate progression update
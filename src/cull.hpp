@@ -0,0 +1,87 @@
+// View culling.
+// Responsibility: the play camera's world-space view rect for a frame, and
+// per-pass drawn/culled counts for profiling.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// World-space AABB seen by the play camera.
+struct ViewRect {
+    glm::vec2 min{0.0f, 0.0f};
+    glm::vec2 max{0.0f, 0.0f};
+
+    // True if the box centred at `c` with half extents `h` touches the view.
+    bool overlaps(glm::vec2 c, glm::vec2 h) const {
+        return c.x + h.x >= min.x && c.x - h.x <= max.x && c.y + h.y >= min.y && c.y - h.y <= max.y;
+    }
+    // Grown by `d` world units on every side (for labels and bars drawn
+    // outside an object's own box).
+    ViewRect padded(float d) const {
+        return ViewRect{min - glm::vec2{d, d}, max + glm::vec2{d, d}};
+    }
+};
+
+// View of a width x height output centred on `cam`; `scale` is pixels per
+// world unit (TILE_SIZE * zoom).
+inline ViewRect view_rect(glm::vec2 cam, float scale, int width, int height) {
+    glm::vec2 half{static_cast<float>(width) * 0.5f / scale, static_cast<float>(height) * 0.5f / scale};
+    return ViewRect{cam - half, cam + half};
+}
+
+enum CullPass : std::uint8_t {
+    CULL_TILE_CHUNKS,
+    CULL_CRATES,
+    CULL_ENTITIES,
+    CULL_HEALTH_BARS,
+    CULL_PICKUPS,
+    CULL_GROUND_ITEMS,
+    CULL_GROUND_GUNS,
+    CULL_PROJECTILES,
+    CULL_PASSES,
+};
+
+inline constexpr std::array<const char*, CULL_PASSES> CULL_PASS_NAMES = {
+    "tile_chunks", "crates", "entities", "health_bars", "pickups", "ground_items", "ground_guns", "projectiles",
+};
+
+// Counts for the last finished frame plus running totals.
+struct CullStats {
+    std::array<std::uint32_t, CULL_PASSES> drawn{};
+    std::array<std::uint32_t, CULL_PASSES> culled{};
+    std::array<std::uint32_t, CULL_PASSES> last_drawn{};
+    std::array<std::uint32_t, CULL_PASSES> last_culled{};
+    std::array<std::uint64_t, CULL_PASSES> total_drawn{};
+    std::array<std::uint64_t, CULL_PASSES> total_culled{};
+    std::uint64_t frames{0};
+
+    // Count one object of `pass`; returns `visible` so a pass can test and
+    // count in one go.
+    bool count(CullPass pass, bool visible) {
+        (visible ? drawn : culled)[pass] += 1;
+        return visible;
+    }
+    void end_frame() {
+        for (std::size_t i = 0; i < CULL_PASSES; ++i) {
+            total_drawn[i] += drawn[i];
+            total_culled[i] += culled[i];
+        }
+        last_drawn = drawn;
+        last_culled = culled;
+        drawn.fill(0);
+        culled.fill(0);
+        frames += 1;
+    }
+    std::uint32_t frame_drawn() const {
+        std::uint32_t n = 0;
+        for (auto v : last_drawn) n += v;
+        return n;
+    }
+    std::uint32_t frame_culled() const {
+        std::uint32_t n = 0;
+        for (auto v : last_culled) n += v;
+        return n;
+    }
+};
@@ -1,30 +1,47 @@
 #include "entities.hpp"
 
 Entities::Entities() {
-    items.reserve(MAX);
-    free_ids.reserve(MAX);
-    for (std::size_t i = 0; i < MAX; ++i) {
-        Entity e{};
-        e.vid.id = i;
-        items.push_back(e);
-        free_ids.insert(free_ids.begin(), i);
-    }
+    items.resize(MAX);
+    colds.resize(MAX);
+    for (std::size_t i = 0; i < MAX; ++i)
+        items[i].vid.id = i;
+    free_ids.resize(MAX);
+    reset_free_ids();
+}
+
+void Entities::reset_free_ids() {
+    for (std::size_t i = 0; i < MAX; ++i)
+        free_ids[i] = i;
+    free_head = 0;
+    free_count = MAX;
 }
 
 std::optional<VID> Entities::new_entity() {
-    if (free_ids.empty())
+    if (free_count == 0)
         return std::nullopt;
-    std::size_t id = free_ids.back();
-    free_ids.pop_back();
+    std::size_t id = free_ids[free_head];
+    free_head = (free_head + 1) % MAX;
+    free_count -= 1;
     Entity& e = items[id];
+    VID vid = e.vid;
+    e = Entity{}; // slots are reused; drop state from the previous occupant
+    e.vid = vid;
+    colds[id] = EntityCold{};
     e.active = true;
     e.vid.version += 1;
+    active_bits[id / 64] |= std::uint64_t{1} << (id % 64);
+    live_count += 1;
     return e.vid;
 }
 
 void Entities::set_inactive(std::size_t id) {
+    if (!items[id].active)
+        return;
     items[id].active = false;
-    free_ids.insert(free_ids.begin(), id);
+    active_bits[id / 64] &= ~(std::uint64_t{1} << (id % 64));
+    live_count -= 1;
+    free_ids[(free_head + free_count) % MAX] = id;
+    free_count += 1;
 }
 
 void Entities::set_inactive_vid(VID vid) {
@@ -33,7 +50,18 @@ void Entities::set_inactive_vid(VID vid) {
         set_inactive(vid.id);
 }
 
+void Entities::reset() {
+    for (std::size_t id : active_ids()) {
+        items[id].active = false;
+        items[id].vid.version += 1;
+    }
+    active_bits.fill(0);
+    live_count = 0;
+    reset_free_ids();
+}
+
 Entity* Entities::get_mut(VID vid) {
+    if (vid.id >= MAX) return nullptr; // ids can come from scripts
     Entity& e = items[vid.id];
     if (e.active && e.vid.version == vid.version)
         return &e;
@@ -41,17 +69,9 @@ Entity* Entities::get_mut(VID vid) {
 }
 
 const Entity* Entities::get(VID vid) const {
+    if (vid.id >= MAX) return nullptr; // ids can come from scripts
     const Entity& e = items[vid.id];
     if (e.active && e.vid.version == vid.version)
         return &e;
     return nullptr;
 }
-
-std::vector<VID> Entities::active_vids() const {
-    std::vector<VID> out;
-    out.reserve(items.size());
-    for (auto const& e : items)
-        if (e.active)
-            out.push_back(e.vid);
-    return out;
-}
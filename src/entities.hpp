@@ -2,6 +2,9 @@
 
 #include "entity.hpp"
 
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -9,24 +12,105 @@ struct Entities {
   public:
     static constexpr std::size_t MAX = 1024;
 
+    // Ascending walk over active slots, driven by the live bitset: an entity
+    // spawned ahead of the cursor is visited and one killed ahead of it is
+    // skipped, exactly like scanning data() and testing `active`.
+    template <bool AsVid> struct ActiveIter {
+        const Entities* owner;
+        std::size_t id;
+        auto operator*() const {
+            if constexpr (AsVid)
+                return owner->items[id].vid;
+            else
+                return id;
+        }
+        ActiveIter& operator++() {
+            id = owner->next_active(id + 1);
+            return *this;
+        }
+        bool operator==(const ActiveIter& o) const {
+            return id == o.id;
+        }
+    };
+    template <bool AsVid> struct ActiveRange {
+        const Entities* owner;
+        ActiveIter<AsVid> begin() const {
+            return {owner, owner->next_active(0)};
+        }
+        ActiveIter<AsVid> end() const {
+            return {owner, MAX};
+        }
+    };
+
     Entities();
 
     std::optional<VID> new_entity();
     void set_inactive(std::size_t id);
     void set_inactive_vid(VID vid);
+    // Deactivate every slot in place; outstanding VIDs become stale.
+    void reset();
 
+    // Null for out-of-range ids, inactive slots and stale versions.
     Entity* get_mut(VID vid);
     const Entity* get(VID vid) const;
+    // Cold component of a live entity (same slot as the Entity)
+    EntityCold& cold(const Entity& e) {
+        return colds[e.vid.id];
+    }
+    const EntityCold& cold(const Entity& e) const {
+        return colds[e.vid.id];
+    }
+    // Equipped gun of an entity, if any; null-safe
+    std::optional<VID> equipped_gun(const Entity* e) const {
+        return e ? colds[e->vid.id].equipped_gun_vid : std::nullopt;
+    }
     const Entity& by_id(std::size_t id) const {
         return items[id];
     }
 
-    std::vector<VID> active_vids() const;
+    // Slot ids / VIDs of active entities; no allocation.
+    ActiveRange<false> active_ids() const {
+        return {this};
+    }
+    ActiveRange<true> active_vids() const {
+        return {this};
+    }
+    std::size_t active_count() const {
+        return live_count;
+    }
+
     std::vector<Entity>& data() {
         return items;
     }
+    const std::vector<Entity>& data() const {
+        return items;
+    }
 
   private:
+    static constexpr std::size_t WORDS = MAX / 64;
+
+    void reset_free_ids();
+    // First active slot >= from, or MAX
+    std::size_t next_active(std::size_t from) const {
+        std::size_t w = from / 64;
+        if (w >= WORDS)
+            return MAX;
+        std::uint64_t bits = active_bits[w] & (~std::uint64_t{0} << (from % 64));
+        while (bits == 0) {
+            if (++w >= WORDS)
+                return MAX;
+            bits = active_bits[w];
+        }
+        return w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+    }
+
     std::vector<Entity> items;
+    std::vector<EntityCold> colds;
+    // FIFO ring of free slot ids: freed ids are reused last
     std::vector<std::size_t> free_ids;
+    std::size_t free_head{0};
+    std::size_t free_count{0};
+    // Bit i set <=> items[i].active
+    std::array<std::uint64_t, WORDS> active_bits{};
+    std::size_t live_count{0};
 };
@@ -5,6 +5,8 @@
 #include <glm/glm.hpp>
 #include <optional>
 
+// Hot per-entity data: transform, collider and the few fields read every
+// tick by movement, projectile hits and rendering.
 struct Entity {
     bool active{false};
     bool marked_for_destruction{false};
@@ -28,11 +30,6 @@ struct Entity {
     int physics_steps{1};
     int sprite_id{-1};
     int def_type{0}; // entity type def id from Lua (if any)
-    float tick_acc_entity{0.0f}; // for per-entity Lua ticks
-    // Threshold tracking for hooks
-    float last_hp_ratio{1.0f};
-    float last_shield_ratio{1.0f};
-    int last_plates{-1};
 
     inline glm::vec2 half_size() const {
         return 0.5f * size;
@@ -40,7 +37,14 @@ struct Entity {
     inline glm::vec2 draw_size() const {
         return (sprite_size.x > 0.0f && sprite_size.y > 0.0f) ? sprite_size : size;
     }
+};
 
+// Cold per-entity data: stats, equipment and hook bookkeeping. Stored by
+// Entities in a parallel array indexed by the same slot id, which keeps
+// Entity at 96 bytes instead of 232. At the 1024-entity cap both layouts fit
+// in L2, and --bench-projectiles times them the same; the split is about
+// size, not a measured speedup.
+struct EntityCold {
     // Basic stat block (inspired by SYNTHETIK style). Units are engine-defined.
     struct Stats {
         // Survivability
@@ -79,6 +83,11 @@ struct Entity {
         float move_spread_max_deg{20.0f};
     } stats{};
 
+    // Threshold tracking for hooks
+    float last_hp_ratio{1.0f};
+    float last_shield_ratio{1.0f};
+    int last_plates{-1};
+
     // Equipment
     std::optional<VID> equipped_gun_vid{};
     // Accuracy: accumulated movement spread (deg), rises with movement, decays at rest
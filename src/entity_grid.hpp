@@ -0,0 +1,113 @@
+// Uniform-grid broadphase over active entities.
+// Responsibility: bucket entity AABBs by Stage tile so hit queries only visit
+// nearby entities instead of every slot.
+#pragma once
+
+#include "entities.hpp"
+#include "stage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// One cell per Stage tile. Rebuilt once per tick (entities do not move or die
+// while projectiles step), stored CSR-style: cell_start[c]..cell_start[c+1]
+// indexes into cell_items, which holds entity slot ids.
+struct EntityGrid {
+  public:
+    void build(const Stage& stage, const Entities& entities) {
+        auto const& ents = entities.data();
+        width = static_cast<int>(stage.get_width());
+        height = static_cast<int>(stage.get_height());
+        std::size_t cells = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        cell_start.assign(cells + 1, 0u);
+        cell_items.clear();
+        if (cells == 0)
+            return;
+        // Pass 1: count entries per cell (shifted by one for the prefix sum)
+        for (std::size_t id : entities.active_ids()) {
+            auto const& e = ents[id];
+            CellRange r = cell_range(e.pos - e.half_size(), e.pos + e.half_size());
+            for (int y = r.miny; y <= r.maxy; ++y)
+                for (int x = r.minx; x <= r.maxx; ++x)
+                    cell_start[cell_index(x, y) + 1] += 1u;
+        }
+        for (std::size_t c = 0; c < cells; ++c)
+            cell_start[c + 1] += cell_start[c];
+        cell_items.resize(cell_start[cells]);
+        // Pass 2: scatter slot ids; cursor reuses a scratch copy of the offsets
+        cursor.assign(cell_start.begin(), cell_start.end() - 1);
+        for (std::size_t id : entities.active_ids()) {
+            auto const& e = ents[id];
+            CellRange r = cell_range(e.pos - e.half_size(), e.pos + e.half_size());
+            for (int y = r.miny; y <= r.maxy; ++y)
+                for (int x = r.minx; x <= r.maxx; ++x)
+                    cell_items[cursor[cell_index(x, y)]++] = static_cast<std::uint32_t>(id);
+        }
+    }
+
+    // Collect slot ids of entities bucketed in any cell touched by [tl, br].
+    // Output is sorted ascending and de-duplicated so callers can visit
+    // candidates in the same order as a linear scan over all slots.
+    void query(glm::vec2 tl, glm::vec2 br, std::vector<std::uint32_t>& out) const {
+        out.clear();
+        if (width <= 0 || height <= 0)
+            return;
+        CellRange r = cell_range(tl, br);
+        for (int y = r.miny; y <= r.maxy; ++y)
+            for (int x = r.minx; x <= r.maxx; ++x) {
+                std::size_t c = cell_index(x, y);
+                out.insert(out.end(), cell_items.begin() + static_cast<std::ptrdiff_t>(cell_start[c]),
+                           cell_items.begin() + static_cast<std::ptrdiff_t>(cell_start[c + 1]));
+            }
+        if (r.minx != r.maxx || r.miny != r.maxy) {
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+    }
+
+    // True if any cell touched by [tl, br] holds an entity.
+    bool any(glm::vec2 tl, glm::vec2 br) const {
+        if (width <= 0 || height <= 0)
+            return false;
+        CellRange r = cell_range(tl, br);
+        for (int y = r.miny; y <= r.maxy; ++y)
+            for (int x = r.minx; x <= r.maxx; ++x) {
+                std::size_t c = cell_index(x, y);
+                if (cell_start[c] != cell_start[c + 1])
+                    return true;
+            }
+        return false;
+    }
+
+  private:
+    struct CellRange {
+        int minx, miny, maxx, maxy;
+    };
+
+    // Out-of-stage extents clamp to the border cells on both the insert and
+    // query side, so overlapping boxes always share at least one cell.
+    CellRange cell_range(glm::vec2 tl, glm::vec2 br) const {
+        auto clampi = [](float v, int hi) {
+            if (!(v > 0.0f))
+                return 0;
+            if (v >= static_cast<float>(hi))
+                return hi;
+            return static_cast<int>(v);
+        };
+        return CellRange{clampi(std::floor(tl.x), width - 1), clampi(std::floor(tl.y), height - 1),
+                         clampi(std::floor(br.x), width - 1), clampi(std::floor(br.y), height - 1)};
+    }
+    std::size_t cell_index(int x, int y) const {
+        return static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x);
+    }
+
+    int width{0};
+    int height{0};
+    std::vector<std::uint32_t> cell_start;
+    std::vector<std::uint32_t> cell_items;
+    std::vector<std::uint32_t> cursor;
+};
@@ -130,6 +130,8 @@ void cleanup_graphics() {
     if (gg->ui_font) { TTF_CloseFont(gg->ui_font); gg->ui_font = nullptr; }
     // Destroy textures before renderer
     clear_textures();
+    clear_text_cache();
+    clear_tile_layer();
     if (gg->renderer) {
         SDL_DestroyRenderer(gg->renderer);
         gg->renderer = nullptr;
@@ -147,49 +149,67 @@ void cleanup_graphics() {
 // ---- Registry ----
 
 void build_sprite_name_id_mapping(const std::vector<std::string>& names) {
-    gg->sprite_name_to_id.clear();
+    gg->sprite_sym_to_id.clear();
     gg->sprite_id_to_name.clear();
     gg->sprite_id_to_name.reserve(names.size());
     for (const auto& n : names) {
+        std::optional<Sym> key = intern(n);
+        if (!key) continue; // refused: its id belongs to another name
         int id = static_cast<int>(gg->sprite_id_to_name.size());
-        gg->sprite_name_to_id.emplace(n, id);
+        gg->sprite_sym_to_id.emplace(*key, id);
         gg->sprite_id_to_name.push_back(n);
     }
 }
 
 int add_or_get_sprite_id(const std::string& name) {
-    auto it = gg->sprite_name_to_id.find(name);
-    if (it != gg->sprite_name_to_id.end()) return it->second;
+    std::optional<Sym> key = intern(name);
+    if (!key) return -1;
+    auto it = gg->sprite_sym_to_id.find(*key);
+    if (it != gg->sprite_sym_to_id.end()) return it->second;
     int id = static_cast<int>(gg->sprite_id_to_name.size());
-    gg->sprite_name_to_id.emplace(name, id);
+    gg->sprite_sym_to_id.emplace(*key, id);
     gg->sprite_id_to_name.push_back(name);
     return id;
 }
 
-int try_get_sprite_id(const std::string& name) {
-    auto it = gg->sprite_name_to_id.find(name);
-    return (it == gg->sprite_name_to_id.end()) ? -1 : it->second;
+int try_get_sprite_id(std::string_view name) {
+    return try_get_sprite_id(sym_key(name));
+}
+
+int try_get_sprite_id(SymKey name) {
+    auto it = gg->sprite_sym_to_id.find(name.sym);
+    if (it == gg->sprite_sym_to_id.end()) return -1;
+    // An unknown name can still hash to a registered one's id
+    return gg->sprite_id_to_name[static_cast<std::size_t>(it->second)] == name.name ? it->second : -1;
 }
 
 // ---- Sprite definitions ----
 
-void rebuild_sprite_mapping(const std::vector<SpriteDef>& new_defs) {
+void rebuild_sprite_mapping(const std::vector<SpriteDef>& all_defs) {
 
-    auto& name_to_id = gg->sprite_name_to_id;
+    auto& name_to_id = gg->sprite_sym_to_id;
     auto& id_to_name = gg->sprite_id_to_name;
     auto& defs_by_id = gg->sprite_defs_by_id;
 
+    // Defs whose name is refused by intern() are dropped, so no id ever
+    // resolves to a sprite of another name.
+    std::vector<std::pair<Sym, const SpriteDef*>> new_defs;
+    new_defs.reserve(all_defs.size());
+    for (const auto& d : all_defs) {
+        if (std::optional<Sym> key = intern(d.name)) new_defs.emplace_back(*key, &d);
+    }
+
     bool only_additions = true;
     if (!name_to_id.empty()) {
-        std::unordered_map<std::string, int> new_names;
+        std::unordered_map<Sym, int> new_names;
         new_names.reserve(new_defs.size());
-        for (const auto& d : new_defs) new_names.emplace(d.name, 1);
+        for (const auto& [key, d] : new_defs) new_names.emplace(key, 1);
         for (const auto& kv : name_to_id) {
             if (new_names.find(kv.first) == new_names.end()) { only_additions = false; break; }
         }
     }
 
-    std::unordered_map<std::string, int> new_name_to_id;
+    std::unordered_map<Sym, int> new_name_to_id;
     std::vector<std::string> new_id_to_name;
     std::vector<SpriteDef> new_defs_by_id;
     new_name_to_id.reserve(new_defs.size());
@@ -198,30 +218,30 @@ void rebuild_sprite_mapping(const std::vector<SpriteDef>& new_defs) {
     if (!name_to_id.empty() && only_additions) {
         new_defs_by_id = std::vector<SpriteDef>(defs_by_id.size());
         new_id_to_name = id_to_name;
-        for (const auto& d : new_defs) {
-            auto it = name_to_id.find(d.name);
+        for (const auto& [key, d] : new_defs) {
+            auto it = name_to_id.find(key);
             if (it != name_to_id.end()) {
                 int id = it->second;
                 if (id >= 0 && static_cast<size_t>(id) < new_defs_by_id.size()) {
-                    new_defs_by_id[static_cast<size_t>(id)] = d;
-                    new_name_to_id.emplace(d.name, id);
+                    new_defs_by_id[static_cast<size_t>(id)] = *d;
+                    new_name_to_id.emplace(key, id);
                 }
             }
         }
-        for (const auto& d : new_defs) {
-            if (new_name_to_id.find(d.name) != new_name_to_id.end()) continue;
+        for (const auto& [key, d] : new_defs) {
+            if (new_name_to_id.find(key) != new_name_to_id.end()) continue;
             int id = static_cast<int>(new_defs_by_id.size());
-            new_defs_by_id.push_back(d);
-            new_id_to_name.push_back(d.name);
-            new_name_to_id.emplace(d.name, id);
+            new_defs_by_id.push_back(*d);
+            new_id_to_name.push_back(d->name);
+            new_name_to_id.emplace(key, id);
         }
     } else {
         new_defs_by_id.reserve(new_defs.size());
-        for (const auto& d : new_defs) {
+        for (const auto& [key, d] : new_defs) {
             int id = static_cast<int>(new_defs_by_id.size());
-            new_defs_by_id.push_back(d);
-            new_name_to_id.emplace(d.name, id);
-            new_id_to_name.push_back(d.name);
+            new_defs_by_id.push_back(*d);
+            new_name_to_id.emplace(key, id);
+            new_id_to_name.push_back(d->name);
         }
     }
 
@@ -245,32 +265,23 @@ const SpriteDef* try_get_sprite_def(const std::string& name) {
 // ---- Textures ----
 
 void clear_textures() {
-    for (auto& kv : gg->textures_by_id) {
-        if (kv.second) SDL_DestroyTexture(kv.second);
-    }
-    gg->textures_by_id.clear();
+    atlas_clear(gg->atlas);
 }
 
-/// Runs through the sprite defs from the last mod scan and loads the textures.
-/// Heavy. Dont run often.
+/// Packs the images of the sprite defs from the last mod scan into atlas
+/// pages. Reads every image once for its size; page textures are made on
+/// first draw. Heavy. Dont run often.
 bool load_all_textures_in_sprite_lookup() {
     if (!gg->renderer) return false;
+    std::vector<std::string> paths(gg->sprite_defs_by_id.size());
     for (int id = 0; id < static_cast<int>(gg->sprite_defs_by_id.size()); ++id) {
         const auto* def = get_sprite_def_by_id(id);
-        if (!def) continue;
-        if (def->image_path.empty()) continue;
-        SDL_Texture* tex = IMG_LoadTexture(gg->renderer, def->image_path.c_str());
-        if (!tex) {
-            std::fprintf(stderr, "IMG_LoadTexture failed for %s: %s\n", def->image_path.c_str(),
-                         IMG_GetError());
-            continue;
-        }
-        gg->textures_by_id[id] = tex;
+        if (def) paths[static_cast<std::size_t>(id)] = def->image_path;
     }
+    atlas_build(gg->atlas, paths);
     return true;
 }
 
-SDL_Texture* get_texture(int sprite_id) {
-    auto it = gg->textures_by_id.find(sprite_id);
-    return (it == gg->textures_by_id.end()) ? nullptr : it->second;
+SpriteTex get_sprite_tex(int sprite_id) {
+    return atlas_get(gg->atlas, gg->renderer, sprite_id);
 }
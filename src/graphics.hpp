@@ -8,7 +8,13 @@
 #include <unordered_map>
 #include <vector>
 
+#include "atlas.hpp"
+#include "cull.hpp"
+#include "sprite_batch.hpp"
 #include "sprites.hpp" // for SpriteDef metadata
+#include "symbols.hpp"
+#include "text.hpp"
+#include "tile_layer.hpp"
 
 inline constexpr float TILE_SIZE = 16.0f;
 
@@ -29,6 +35,7 @@ struct Graphics {
     SDL_Window* window{nullptr};
     SDL_Renderer* renderer{nullptr};
     TTF_Font* ui_font{nullptr};
+    TextCache text{}; // glyph atlas and layouts for ui_font
 
     glm::uvec2 window_dims{1280, 720};
     glm::uvec2 dims{1280, 720};
@@ -38,12 +45,21 @@ struct Graphics {
     PlayCam play_cam{};
 
     // Sprite registry and definitions
-    std::unordered_map<std::string, int> sprite_name_to_id;
+    std::unordered_map<Sym, int> sprite_sym_to_id;
     std::vector<std::string> sprite_id_to_name; // index == id
     std::vector<SpriteDef> sprite_defs_by_id;   // index == id
 
-    // Textures keyed by sprite id
-    std::unordered_map<int, SDL_Texture*> textures_by_id;
+    // Sprite images packed into atlas pages, resident on demand
+    TextureAtlas atlas{};
+
+    // World sprite quads queued for this layer
+    SpriteBatch batch{};
+
+    // Stage tiles cached per chunk
+    TileLayer tiles{};
+
+    // Per-pass view culling counts
+    CullStats cull{};
 };
 
 // Initialize window/renderer into Graphics. When headless is true, no window/renderer is created.
@@ -64,7 +80,8 @@ bool try_init_video_with_driver(const char* driver);
 // Registry operations
 void build_sprite_name_id_mapping(const std::vector<std::string>& names);
 int add_or_get_sprite_id(const std::string& name);
-int try_get_sprite_id(const std::string& name);
+int try_get_sprite_id(std::string_view name);
+int try_get_sprite_id(SymKey name);
 
 // Sprite definitions operations
 void rebuild_sprite_mapping(const std::vector<SpriteDef>& defs);
@@ -74,4 +91,5 @@ const SpriteDef* try_get_sprite_def(const std::string& name);
 // Textures operations
 void clear_textures();
 bool load_all_textures_in_sprite_lookup();
-SDL_Texture* get_texture(int sprite_id);
+// Page texture and source rect for a sprite; loads its page on first use.
+SpriteTex get_sprite_tex(int sprite_id);
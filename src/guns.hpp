@@ -29,8 +29,6 @@ struct GunInstance {
   float ar_window_end{0.0f};   // fraction 0..1
   bool ar_consumed{false};
   bool ar_failed_attempt{false};
-  // Optional ticking accumulator (opt-in via def.tick_rate_hz)
-  float tick_acc{0.0f};
   // Selected ammo type (Lua AmmoDef::type). 0 means unset/default.
   int ammo_type{0};
 };
@@ -76,34 +74,17 @@ struct GroundGun {
     int sprite_id{-1};
 };
 
-struct GroundGunsPool {
+struct GroundGunsPool : public Pool<GroundGun, 1024> {
   public:
     static constexpr std::size_t MAX = 1024;
-    GroundGunsPool() {
-        items.resize(MAX);
-    }
     GroundGun* spawn(VID gun_vid, glm::vec2 p, int sprite_id) {
-        for (auto& g : items)
-            if (!g.active) {
-                g.active = true;
-                g.gun_vid = gun_vid;
-                g.pos = p;
-                g.sprite_id = sprite_id;
-                return &g;
-            }
-        return nullptr;
-    }
-    void clear() {
-        for (auto& g : items)
-            g.active = false;
-    }
-    std::vector<GroundGun>& data() {
-        return items;
-    }
-    const std::vector<GroundGun>& data() const {
-        return items;
+        auto v = alloc();
+        if (!v)
+            return nullptr;
+        GroundGun* g = get(*v);
+        g->gun_vid = gun_vid;
+        g->pos = p;
+        g->sprite_id = sprite_id;
+        return g;
     }
-
-  private:
-    std::vector<GroundGun> items;
 };
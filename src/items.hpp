@@ -17,8 +17,6 @@ struct ItemInstance {
     float use_cooldown{0.0f};
     float use_cooldown_countdown{0.0f};
     uint32_t modifiers_hash{0}; // items with different mods must not stack
-    // Optional ticking accumulator (opt-in via def.tick_rate_hz)
-    float tick_acc{0.0f};
 };
 
 struct ItemsPool : public Pool<ItemInstance, 1024> {
@@ -43,33 +41,16 @@ struct GroundItem {
     glm::vec2 size{0.125f, 0.125f};
 };
 
-struct GroundItemsPool {
+struct GroundItemsPool : public Pool<GroundItem, 1024> {
   public:
     static constexpr std::size_t MAX = 1024;
-    GroundItemsPool() {
-        items.resize(MAX);
-    }
     GroundItem* spawn(VID item_vid, glm::vec2 pos) {
-        for (auto& gi : items)
-            if (!gi.active) {
-                gi.active = true;
-                gi.item_vid = item_vid;
-                gi.pos = pos;
-                return &gi;
-            }
-        return nullptr;
-    }
-    void clear() {
-        for (auto& gi : items)
-            gi.active = false;
-    }
-    std::vector<GroundItem>& data() {
-        return items;
-    }
-    const std::vector<GroundItem>& data() const {
-        return items;
+        auto v = alloc();
+        if (!v)
+            return nullptr;
+        GroundItem* gi = get(*v);
+        gi->item_vid = item_vid;
+        gi->pos = pos;
+        return gi;
     }
-
-  private:
-    std::vector<GroundItem> items;
 };
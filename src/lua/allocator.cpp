@@ -0,0 +1,177 @@
+#include "lua/allocator.hpp"
+// allocator: pooled lua_Alloc with per-mod accounting, paced GC
+
+#include <lua.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t SMALL_MAX = LuaMemory::GRAIN * LuaMemory::CLASSES;
+constexpr std::size_t GC_MIN_HEAP = 1024 * 1024; // no stepping below this
+constexpr int GC_STEP_KB = 16;
+constexpr int GC_DEBT_STEPS = 8; // per call when over 2x, time or not
+
+std::uint16_t g_owner = 0;
+
+// Large blocks carry their owner in front; GRAIN keeps the payload aligned.
+struct LargeHeader {
+    std::uint16_t owner;
+};
+static_assert(sizeof(LargeHeader) <= LuaMemory::GRAIN);
+
+std::size_t class_of(std::size_t n) { return (n + LuaMemory::GRAIN - 1) / LuaMemory::GRAIN - 1; }
+
+std::uint16_t slab_owner(void* p) {
+    auto base = reinterpret_cast<std::uintptr_t>(p) & ~(LuaMemory::SLAB - 1);
+    return *reinterpret_cast<std::uint16_t*>(base);
+}
+
+void charge(LuaMemory& m, std::uint16_t owner, std::size_t n) {
+    LuaModMem& mm = m.mods[owner];
+    mm.bytes += n;
+    mm.allocs += 1;
+    mm.peak = std::max(mm.peak, mm.bytes);
+    m.total += n;
+}
+
+void refund(LuaMemory& m, std::uint16_t owner, std::size_t n) {
+    m.mods[owner].bytes -= n;
+    m.total -= n;
+}
+
+void* small_alloc(LuaMemory& m, std::uint16_t owner, std::size_t n) {
+    std::size_t c = class_of(n);
+    LuaMemory::Pool& p = m.pools[owner][c];
+    void* b = p.free;
+    if (b) {
+        std::memcpy(&p.free, b, sizeof(void*));
+    } else {
+        std::size_t size = (c + 1) * LuaMemory::GRAIN;
+        if (p.bump == nullptr || static_cast<std::size_t>(p.end - p.bump) < size) {
+            void* slab = std::aligned_alloc(LuaMemory::SLAB, LuaMemory::SLAB);
+            if (!slab) return nullptr;
+            m.slabs.push_back(slab);
+            m.reserved += LuaMemory::SLAB;
+            *static_cast<std::uint16_t*>(slab) = owner;
+            p.bump = static_cast<char*>(slab) + LuaMemory::GRAIN;
+            p.end = static_cast<char*>(slab) + LuaMemory::SLAB;
+        }
+        b = p.bump;
+        p.bump += size;
+    }
+    charge(m, owner, n);
+    return b;
+}
+
+void small_free(LuaMemory& m, void* b, std::size_t n) {
+    std::uint16_t owner = slab_owner(b);
+    LuaMemory::Pool& p = m.pools[owner][class_of(n)];
+    std::memcpy(b, &p.free, sizeof(void*));
+    p.free = b;
+    refund(m, owner, n);
+}
+
+void* large_alloc(LuaMemory& m, std::uint16_t owner, std::size_t n) {
+    auto* h = static_cast<LargeHeader*>(std::malloc(LuaMemory::GRAIN + n));
+    if (!h) return nullptr;
+    h->owner = owner;
+    m.reserved += LuaMemory::GRAIN + n;
+    charge(m, owner, n);
+    return reinterpret_cast<char*>(h) + LuaMemory::GRAIN;
+}
+
+LargeHeader* large_header(void* b) { return reinterpret_cast<LargeHeader*>(static_cast<char*>(b) - LuaMemory::GRAIN); }
+
+void large_free(LuaMemory& m, void* b, std::size_t n) {
+    LargeHeader* h = large_header(b);
+    refund(m, h->owner, n);
+    m.reserved -= LuaMemory::GRAIN + n;
+    std::free(h);
+}
+
+void* fresh(LuaMemory& m, std::size_t n) {
+    return n <= SMALL_MAX ? small_alloc(m, g_owner, n) : large_alloc(m, g_owner, n);
+}
+
+void release(LuaMemory& m, void* b, std::size_t n) {
+    if (n <= SMALL_MAX) small_free(m, b, n);
+    else large_free(m, b, n);
+}
+
+} // namespace
+
+LuaMemory::LuaMemory() { mod_id("engine"); }
+
+LuaMemory::~LuaMemory() {
+    // The state is closed by now; whatever is left (large blocks) leaked with it
+    for (void* s : slabs) std::free(s);
+}
+
+std::uint16_t LuaMemory::mod_id(const std::string& name) {
+    for (std::size_t i = 0; i < mods.size(); ++i)
+        if (mods[i].name == name) return static_cast<std::uint16_t>(i);
+    if (mods.size() > UINT16_MAX) return 0;
+    mods.push_back(LuaModMem{name, 0, 0, 0});
+    pools.emplace_back();
+    return static_cast<std::uint16_t>(mods.size() - 1);
+}
+
+void* lua_mem_alloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize) {
+    LuaMemory& m = *static_cast<LuaMemory*>(ud);
+    if (!ptr) return nsize ? fresh(m, nsize) : nullptr; // osize is a type tag here
+    if (nsize == 0) {
+        release(m, ptr, osize);
+        return nullptr;
+    }
+    if (osize <= SMALL_MAX && nsize <= SMALL_MAX && class_of(osize) == class_of(nsize)) {
+        std::uint16_t owner = slab_owner(ptr);
+        refund(m, owner, osize);
+        charge(m, owner, nsize);
+        return ptr;
+    }
+    if (osize > SMALL_MAX && nsize > SMALL_MAX) {
+        LargeHeader* h = large_header(ptr);
+        std::uint16_t owner = h->owner;
+        auto* g = static_cast<LargeHeader*>(std::realloc(h, LuaMemory::GRAIN + nsize));
+        if (!g) return nullptr;
+        refund(m, owner, osize);
+        charge(m, owner, nsize);
+        m.reserved = m.reserved - osize + nsize;
+        return reinterpret_cast<char*>(g) + LuaMemory::GRAIN;
+    }
+    // Crossing between pooled and large: the block moves to the current owner
+    void* b = fresh(m, nsize);
+    if (!b) return nullptr; // Lua keeps the old block
+    std::memcpy(b, ptr, std::min(osize, nsize));
+    release(m, ptr, osize);
+    return b;
+}
+
+std::uint16_t lua_mem_owner() { return g_owner; }
+
+LuaMemScope::LuaMemScope(std::uint16_t mod) : prev(g_owner) { g_owner = mod; }
+
+LuaMemScope::~LuaMemScope() { g_owner = prev; }
+
+void lua_gc_step(lua_State* L, LuaMemory& mem, double seconds) {
+    const std::size_t floor = std::max(mem.gc_floor, GC_MIN_HEAP);
+    if (!mem.gc_active && mem.total < floor + floor / 2) return;
+    const bool debt = mem.total > 2 * floor;
+    if (seconds <= 0.0 && !debt) return;
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::duration<double>(std::max(0.0, seconds));
+    for (int steps = 0;; ++steps) {
+        mem.gc_active = true;
+        if (lua_gc(L, LUA_GCSTEP, GC_STEP_KB)) {
+            mem.gc_active = false;
+            mem.gc_floor = mem.total;
+            mem.gc_cycles += 1;
+            return;
+        }
+        if (clock::now() >= deadline && !(debt && steps < GC_DEBT_STEPS)) return;
+    }
+}
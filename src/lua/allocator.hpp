@@ -0,0 +1,73 @@
+// Lua allocator.
+// Responsibility: the lua_Alloc for the mod state (size-class pools for small
+// blocks, malloc for the rest), bytes charged to the mod that allocated them,
+// and incremental GC steps paced from the main loop.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+struct LuaModMem {
+    std::string name;
+    std::size_t bytes{0}; // live
+    std::size_t peak{0};
+    std::uint64_t allocs{0};
+};
+
+struct LuaMemory {
+    // Pooled sizes are GRAIN..GRAIN*CLASSES. Pool blocks come from SLAB-sized,
+    // SLAB-aligned slabs owned by one mod; the slab header names the owner.
+    static constexpr std::size_t GRAIN = 16;
+    static constexpr std::size_t CLASSES = 32;
+    static constexpr std::size_t SLAB = 16 * 1024;
+
+    struct Pool {
+        void* free{nullptr};
+        char* bump{nullptr};
+        char* end{nullptr};
+    };
+
+    std::vector<LuaModMem> mods;                   // [0] = engine and unattributed
+    std::vector<std::array<Pool, CLASSES>> pools;  // per mod
+    std::vector<void*> slabs;
+    std::size_t total{0};    // live bytes, all mods
+    std::size_t reserved{0}; // slabs plus large blocks
+    // GC pacing
+    std::size_t gc_floor{0}; // live bytes after the last finished cycle
+    bool gc_active{false};   // a cycle is part way through
+    std::uint64_t gc_cycles{0};
+
+    LuaMemory();
+    ~LuaMemory();
+    LuaMemory(const LuaMemory&) = delete;
+    LuaMemory& operator=(const LuaMemory&) = delete;
+
+    // Stable per name, so blocks outliving a reload keep their owner.
+    std::uint16_t mod_id(const std::string& name);
+};
+
+// ud is the LuaMemory.
+void* lua_mem_alloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+
+// New blocks are charged to the current owner (a LuaMemory::mods index).
+std::uint16_t lua_mem_owner();
+
+struct LuaMemScope {
+    explicit LuaMemScope(std::uint16_t mod);
+    ~LuaMemScope();
+    LuaMemScope(const LuaMemScope&) = delete;
+    LuaMemScope& operator=(const LuaMemScope&) = delete;
+
+  private:
+    std::uint16_t prev;
+};
+
+// The state runs with the collector stopped; call this between frames with
+// the spare time. Steps run only once the heap has grown past the last
+// cycle's size, and run anyway (a few) when it has more than doubled.
+void lua_gc_step(lua_State* L, LuaMemory& mem, double seconds);
@@ -8,11 +8,12 @@ void lua_register_api_player(sol::state& s, LuaManager& m) {
     (void)m;
     auto api = s.create_named_table("api");
     api.set_function("add_plate", [](int n) {
-        if (g_player_ctx) {
-            g_player_ctx->stats.plates += n;
-            if (g_player_ctx->stats.plates < 0)
-                g_player_ctx->stats.plates = 0;
-            if (g_state_ctx && n > 0) {
+        if (g_state_ctx && g_player_ctx) {
+            auto& stats = g_state_ctx->entities.cold(*g_player_ctx).stats;
+            stats.plates += n;
+            if (stats.plates < 0)
+                stats.plates = 0;
+            if (n > 0) {
                 if (auto* pm = g_state_ctx->metrics_for(g_player_ctx->vid))
                     pm->plates_gained += (uint32_t)n;
             }
@@ -32,8 +33,8 @@ void lua_register_api_player(sol::state& s, LuaManager& m) {
         }
     });
     api.set_function("add_move_speed", [](int n) {
-        if (g_player_ctx) {
-            g_player_ctx->stats.move_speed += (float)n;
+        if (g_state_ctx && g_player_ctx) {
+            g_state_ctx->entities.cold(*g_player_ctx).stats.move_speed += (float)n;
         }
     });
 
@@ -65,19 +66,13 @@ void lua_register_api_player(sol::state& s, LuaManager& m) {
     api.set_function("refill_ammo", []() {
         if (!g_state_ctx || !g_player_ctx)
             return;
-        if (!g_player_ctx->equipped_gun_vid.has_value())
+        auto const& equipped = g_state_ctx->entities.cold(*g_player_ctx).equipped_gun_vid;
+        if (!equipped.has_value())
             return;
-        auto* gi = g_state_ctx->guns.get(*g_player_ctx->equipped_gun_vid);
+        auto* gi = g_state_ctx->guns.get(*equipped);
         if (!gi)
             return;
-        const GunDef* gd = nullptr;
-        if (g_mgr) {
-            for (auto const& g : g_mgr->guns())
-                if (g.type == gi->def_type) {
-                    gd = &g;
-                    break;
-                }
-        }
+        const GunDef* gd = g_mgr ? g_mgr->find_gun(gi->def_type) : nullptr;
         if (!gd)
             return;
         gi->ammo_reserve = gd->ammo_max;
@@ -87,17 +82,14 @@ void lua_register_api_player(sol::state& s, LuaManager& m) {
     api.set_function("set_equipped_ammo", [](int ammo_type) {
         if (!g_state_ctx || !g_player_ctx)
             return;
-        if (!g_player_ctx->equipped_gun_vid.has_value())
+        auto const& equipped = g_state_ctx->entities.cold(*g_player_ctx).equipped_gun_vid;
+        if (!equipped.has_value())
             return;
-        auto* gi = g_state_ctx->guns.get(*g_player_ctx->equipped_gun_vid);
+        auto* gi = g_state_ctx->guns.get(*equipped);
         if (!gi)
             return;
         // Enforce compatibility: only allow ammo listed on gun def
-        const GunDef* gd = nullptr;
-        if (g_mgr) {
-            for (auto const& g : g_mgr->guns())
-                if (g.type == gi->def_type) { gd = &g; break; }
-        }
+        const GunDef* gd = g_mgr ? g_mgr->find_gun(gi->def_type) : nullptr;
         if (!gd)
             return;
         bool ok = false;
@@ -118,9 +110,10 @@ void lua_register_api_player(sol::state& s, LuaManager& m) {
     api.set_function("set_equipped_ammo_force", [](int ammo_type) {
         if (!g_state_ctx || !g_player_ctx)
             return;
-        if (!g_player_ctx->equipped_gun_vid.has_value())
+        auto const& equipped = g_state_ctx->entities.cold(*g_player_ctx).equipped_gun_vid;
+        if (!equipped.has_value())
             return;
-        if (auto* gi = g_state_ctx->guns.get(*g_player_ctx->equipped_gun_vid)) {
+        if (auto* gi = g_state_ctx->guns.get(*equipped)) {
             gi->ammo_type = ammo_type;
             if (g_mgr && g_state_ctx) {
                 if (auto const* ad = g_mgr->find_ammo(ammo_type))
@@ -0,0 +1,157 @@
+#include "luamgr.hpp"
+// api: timers (api.after / api.every / api.cancel, global wait)
+#include "lua/bindings.hpp"
+#include "lua/internal_state.hpp"
+#include "lua/lua_helpers.hpp"
+#include "globals.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Resumes per phase per step; the rest slide to the next step.
+constexpr int TIMER_BUDGET = 1000;
+
+std::uint32_t ticks_for(double seconds) {
+    if (!(seconds > 0.0)) return 1;
+    double t = std::ceil(seconds / static_cast<double>(TIMESTEP) - 1e-6);
+    return static_cast<std::uint32_t>(std::clamp(t, 1.0, 1e9));
+}
+
+void schedule(LuaTimers& T, std::uint32_t id, std::uint32_t ticks) {
+    LuaTimer& t = T.timers[id];
+    t.due = T.now[t.phase] + std::max<std::uint32_t>(1, ticks);
+    T.wheel[t.phase][t.due % LuaTimers::WHEEL].push_back(id);
+}
+
+void release(LuaTimers& T, std::uint32_t id) {
+    LuaTimer& t = T.timers[id];
+    std::uint32_t gen = t.gen + 1;
+    t = LuaTimer{};
+    t.gen = gen;
+    T.free_ids.push_back(id);
+}
+
+// The player while a timer's gun/item still exists and sits in its
+// inventory; nullptr once the instance is dropped or destroyed.
+Entity* instance_holder(const LuaTimer& t) {
+    const bool alive = t.inst_kind == INV_GUN ? ss->guns.get(t.inst) != nullptr : ss->items.get(t.inst) != nullptr;
+    if (!alive || !ss->player_vid) return nullptr;
+    const Inventory* inv = ss->inv_for(*ss->player_vid);
+    if (!inv) return nullptr;
+    for (const auto& e : inv->entries)
+        if (e.kind == t.inst_kind && e.vid.id == t.inst.id && e.vid.version == t.inst.version)
+            return ss->entities.get_mut(*ss->player_vid);
+    return nullptr;
+}
+
+std::int64_t add_timer(LuaTimers& T, double seconds, sol::protected_function fn, std::uint32_t period,
+                       const sol::optional<std::string>& phase) {
+    std::uint32_t id;
+    if (!T.free_ids.empty()) {
+        id = T.free_ids.back();
+        T.free_ids.pop_back();
+    } else {
+        id = static_cast<std::uint32_t>(T.timers.size());
+        T.timers.emplace_back();
+    }
+    LuaTimer& t = T.timers[id];
+    t.fn = std::move(fn);
+    t.period = period;
+    t.phase = phase ? tick_phase_from(*phase) : TICK_AFTER_PHYSICS;
+    t.live = true;
+    t.mod = lua_mem_owner();
+    if (g_instance_ctx.kind != 0) {
+        // Not the holder's VID: the player is re-created on every room change
+        t.inst_kind = g_instance_ctx.kind;
+        t.inst = g_instance_ctx.vid;
+    } else if (g_player_ctx) {
+        t.owner = g_player_ctx->vid;
+        t.has_owner = true;
+    }
+    schedule(T, id, ticks_for(seconds));
+    return (static_cast<std::int64_t>(t.gen) << 32) | id;
+}
+
+} // namespace
+
+void lua_register_api_timers(sol::state& s, LuaManager& m) {
+    sol::table api = s["api"].get_or_create<sol::table>();
+    // Handles are opaque; api.cancel ignores stale ones.
+    api.set_function("after", [&m](double seconds, sol::protected_function fn, sol::optional<std::string> phase) {
+        return add_timer(*m.timers_, seconds, std::move(fn), 0, phase);
+    });
+    // First run after `seconds`; the next is `seconds` after a run (and its
+    // waits) finishes, so runs never overlap.
+    api.set_function("every", [&m](double seconds, sol::protected_function fn, sol::optional<std::string> phase) {
+        return add_timer(*m.timers_, seconds, std::move(fn), ticks_for(seconds), phase);
+    });
+    api.set_function("cancel", [&m](std::int64_t h) {
+        auto id = static_cast<std::uint32_t>(h & 0xffffffff);
+        auto gen = static_cast<std::uint32_t>(h >> 32);
+        LuaTimers& T = *m.timers_;
+        if (id >= T.timers.size() || !T.timers[id].live || T.timers[id].gen != gen) return false;
+        T.timers[id].cancelled = true; // freed when its slot comes up
+        return true;
+    });
+    // Suspends the running timer body; errors outside one.
+    s.set_function("wait", sol::yielding([](sol::optional<double> seconds) { return seconds.value_or(0.0); }));
+}
+
+void LuaManager::run_timers(TickPhase phase) {
+    if (!timers_ || !S || !ss) return;
+    LuaTimers& T = *timers_;
+    const std::uint64_t now = ++T.now[phase];
+    auto& slot = T.wheel[phase][now % LuaTimers::WHEEL];
+    if (slot.empty()) return;
+    T.scratch.clear();
+    T.scratch.swap(slot);
+    int runs = 0;
+    for (std::uint32_t id : T.scratch) {
+        LuaTimer& t = T.timers[id];
+        if (t.cancelled) { release(T, id); continue; }
+        if (t.due > now) { slot.push_back(id); continue; }
+        if (runs >= TIMER_BUDGET || lua_watch_phase_spent()) { schedule(T, id, 1); continue; }
+        Entity* owner = nullptr;
+        if (t.inst_kind != 0) {
+            if (!(owner = instance_holder(t))) { release(T, id); continue; }
+        } else if (t.has_owner && !(owner = ss->entities.get_mut(t.owner))) { release(T, id); continue; }
+        ++runs;
+        if (!t.co.runnable()) {
+            t.thread = sol::thread::create(L);
+            t.co = sol::coroutine(t.thread.thread_state(), t.fn);
+        }
+        // Settle the outcome before touching the timer: the result still
+        // references the coroutine's stack.
+        bool failed = false, yielded = false;
+        double wait_s = 0.0;
+        {
+            LuaCtxGuard _ctx(ss, owner);
+            LuaInstanceGuard _inst(t.inst_kind, t.inst); // timers started by the body inherit it
+            LuaWatch _watch(T.stats);
+            LuaMemScope _mem(t.mod);
+            auto r = t.co();
+            if (!r.valid()) {
+                sol::error e = r;
+                lua_hook_error(_watch, "timer", e.what());
+                failed = true;
+            } else if (r.status() == sol::call_status::yielded) {
+                yielded = true;
+                wait_s = r.get<sol::optional<double>>().value_or(0.0);
+            }
+        }
+        if (failed || t.cancelled) {
+            release(T, id);
+        } else if (yielded) {
+            schedule(T, id, ticks_for(wait_s));
+        } else if (t.period > 0) {
+            t.co = sol::coroutine{};
+            t.thread = sol::thread{};
+            schedule(T, id, t.period);
+        } else {
+            release(T, id);
+        }
+    }
+    T.scratch.clear();
+}
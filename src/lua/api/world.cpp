@@ -4,6 +4,7 @@
 #include "lua/lua_helpers.hpp"
 #include "globals.hpp"
 #include "graphics.hpp"
+#include "scripting_ticks.hpp"
 #include <glm/glm.hpp>
 #include <cmath>
 
@@ -61,8 +62,7 @@ void lua_register_api_world(sol::state& s, LuaManager& m) {
 
     api.set_function("spawn_item", [](int type, int count, float x, float y) {
         if (!g_state_ctx || !g_mgr) return;
-        const ItemDef* id = nullptr;
-        for (auto const& d : g_mgr->items()) if (d.type == type) { id = &d; break; }
+        const ItemDef* id = g_mgr->find_item(type);
         if (!id) return;
         auto iv = g_state_ctx->items.spawn_from_def(*id, (uint32_t)std::max(1, count));
         if (iv) {
@@ -91,8 +91,7 @@ void lua_register_api_world(sol::state& s, LuaManager& m) {
 
     api.set_function("spawn_gun", [](int type, float x, float y) {
         if (!g_state_ctx || !g_mgr) return;
-        const GunDef* gd = nullptr;
-        for (auto const& g : g_mgr->guns()) if (g.type == type) { gd = &g; break; }
+        const GunDef* gd = g_mgr->find_gun(type);
         if (!gd) return;
         auto gv = g_state_ctx->guns.spawn_from_def(*gd);
         if (gv) {
@@ -153,37 +152,47 @@ void lua_register_api_world(sol::state& s, LuaManager& m) {
         e->sprite_size = {ed->sprite_w, ed->sprite_h};
         e->physics_steps = std::max(1, ed->physics_steps);
         e->def_type = ed->type;
-        e->sprite_id = -1;
-        if (!ed->sprite.empty() && ed->sprite.find(':') != std::string::npos)
-            e->sprite_id = try_get_sprite_id(ed->sprite);
+        e->sprite_id = ed->sprite_id;
         e->max_hp = ed->max_hp;
         e->health = e->max_hp;
-        e->stats.shield_max = ed->shield_max;
+        auto& st = g_state_ctx->entities.cold(*e).stats;
+        st.shield_max = ed->shield_max;
         e->shield = ed->shield_max;
-        e->stats.shield_regen = ed->shield_regen;
-        e->stats.health_regen = ed->health_regen;
-        e->stats.armor = ed->armor;
-        e->stats.plates = ed->plates;
-        e->stats.move_speed = ed->move_speed;
-        e->stats.dodge = ed->dodge;
-        e->stats.accuracy = ed->accuracy;
-        e->stats.scavenging = ed->scavenging;
-        e->stats.currency = ed->currency;
-        e->stats.ammo_gain = ed->ammo_gain;
-        e->stats.luck = ed->luck;
-        e->stats.crit_chance = ed->crit_chance;
-        e->stats.crit_damage = ed->crit_damage;
-        e->stats.headshot_damage = ed->headshot_damage;
-        e->stats.damage_absorb = ed->damage_absorb;
-        e->stats.damage_output = ed->damage_output;
-        e->stats.healing = ed->healing;
-        e->stats.terror_level = ed->terror_level;
-        e->stats.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
-        e->stats.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
-        e->stats.move_spread_max_deg = ed->move_spread_max_deg;
+        st.shield_regen = ed->shield_regen;
+        st.health_regen = ed->health_regen;
+        st.armor = ed->armor;
+        st.plates = ed->plates;
+        st.move_speed = ed->move_speed;
+        st.dodge = ed->dodge;
+        st.accuracy = ed->accuracy;
+        st.scavenging = ed->scavenging;
+        st.currency = ed->currency;
+        st.ammo_gain = ed->ammo_gain;
+        st.luck = ed->luck;
+        st.crit_chance = ed->crit_chance;
+        st.crit_damage = ed->crit_damage;
+        st.headshot_damage = ed->headshot_damage;
+        st.damage_absorb = ed->damage_absorb;
+        st.damage_output = ed->damage_output;
+        st.healing = ed->healing;
+        st.terror_level = ed->terror_level;
+        st.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
+        st.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
+        st.move_spread_max_deg = ed->move_spread_max_deg;
+        tick_register_entity(*e);
         g_mgr->call_entity_on_spawn(type, *e);
     });
 
+    // Point the api's implicit entity at `h` (an entity handle, as passed to
+    // on_step_batch) for the rest of the current hook. False if it is gone.
+    api.set_function("use_entity", [](std::int64_t h) {
+        if (!g_state_ctx || h < 0) return false;
+        Entity* e = g_state_ctx->entities.get_mut(entity_vid(h)); // checks the id range
+        if (!e) return false;
+        g_player_ctx = e;
+        return true;
+    });
+
     // Alias: always safe; emits alert on failure
     api.set_function("spawn_entity", [](int type, float x, float y) {
         if (!g_state_ctx) return;
@@ -217,34 +226,34 @@ void lua_register_api_world(sol::state& s, LuaManager& m) {
         e->sprite_size = {ed->sprite_w, ed->sprite_h};
         e->physics_steps = std::max(1, ed->physics_steps);
         e->def_type = ed->type;
-        e->sprite_id = -1;
-        if (!ed->sprite.empty() && ed->sprite.find(':') != std::string::npos)
-            e->sprite_id = try_get_sprite_id(ed->sprite);
+        e->sprite_id = ed->sprite_id;
         e->max_hp = ed->max_hp;
         e->health = e->max_hp;
-        e->stats.shield_max = ed->shield_max;
+        auto& st = g_state_ctx->entities.cold(*e).stats;
+        st.shield_max = ed->shield_max;
         e->shield = ed->shield_max;
-        e->stats.shield_regen = ed->shield_regen;
-        e->stats.health_regen = ed->health_regen;
-        e->stats.armor = ed->armor;
-        e->stats.plates = ed->plates;
-        e->stats.move_speed = ed->move_speed;
-        e->stats.dodge = ed->dodge;
-        e->stats.accuracy = ed->accuracy;
-        e->stats.scavenging = ed->scavenging;
-        e->stats.currency = ed->currency;
-        e->stats.ammo_gain = ed->ammo_gain;
-        e->stats.luck = ed->luck;
-        e->stats.crit_chance = ed->crit_chance;
-        e->stats.crit_damage = ed->crit_damage;
-        e->stats.headshot_damage = ed->headshot_damage;
-        e->stats.damage_absorb = ed->damage_absorb;
-        e->stats.damage_output = ed->damage_output;
-        e->stats.healing = ed->healing;
-        e->stats.terror_level = ed->terror_level;
-        e->stats.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
-        e->stats.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
-        e->stats.move_spread_max_deg = ed->move_spread_max_deg;
+        st.shield_regen = ed->shield_regen;
+        st.health_regen = ed->health_regen;
+        st.armor = ed->armor;
+        st.plates = ed->plates;
+        st.move_speed = ed->move_speed;
+        st.dodge = ed->dodge;
+        st.accuracy = ed->accuracy;
+        st.scavenging = ed->scavenging;
+        st.currency = ed->currency;
+        st.ammo_gain = ed->ammo_gain;
+        st.luck = ed->luck;
+        st.crit_chance = ed->crit_chance;
+        st.crit_damage = ed->crit_damage;
+        st.headshot_damage = ed->headshot_damage;
+        st.damage_absorb = ed->damage_absorb;
+        st.damage_output = ed->damage_output;
+        st.healing = ed->healing;
+        st.terror_level = ed->terror_level;
+        st.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
+        st.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
+        st.move_spread_max_deg = ed->move_spread_max_deg;
+        tick_register_entity(*e);
         g_mgr->call_entity_on_spawn(type, *e);
     });
 }
@@ -16,3 +16,4 @@ void lua_register_entities(sol::state& s, LuaManager& m);
 
 void lua_register_api_player(sol::state& s, LuaManager& m);
 void lua_register_api_world(sol::state& s, LuaManager& m);
+void lua_register_api_timers(sol::state& s, LuaManager& m);
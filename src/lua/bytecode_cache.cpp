@@ -0,0 +1,114 @@
+#include "lua/bytecode_cache.hpp"
+// bytecode cache: lua_dump copies of mod scripts keyed by source stamp
+
+#include <lua.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char MAGIC[4] = {'R', 'L', 'C', '1'};
+
+struct Stamp {
+    std::int64_t mtime{0};
+    std::uint64_t size{0};
+    std::uint32_t lua_release{LUA_VERSION_RELEASE_NUM};
+    std::uint32_t path_len{0};
+};
+
+bool stamp_of(const std::string& path, Stamp& st) {
+    std::error_code ec;
+    auto mt = fs::last_write_time(path, ec);
+    if (ec) return false;
+    auto sz = fs::file_size(path, ec);
+    if (ec) return false;
+    st.mtime = static_cast<std::int64_t>(mt.time_since_epoch().count());
+    st.size = static_cast<std::uint64_t>(sz);
+    st.path_len = static_cast<std::uint32_t>(path.size());
+    return true;
+}
+
+fs::path entry_for(const std::string& dir, const std::string& path) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016zx.luac", std::hash<std::string>{}(path));
+    return fs::path(dir) / name;
+}
+
+// Bytecode after the header if the entry matches `st` and `path`, else empty.
+std::vector<char> read_entry(const fs::path& file, const Stamp& st, const std::string& path) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) return {};
+    char magic[4];
+    Stamp got{};
+    if (!in.read(magic, sizeof(magic)) || !in.read(reinterpret_cast<char*>(&got), sizeof(got))) return {};
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || got.mtime != st.mtime || got.size != st.size ||
+        got.lua_release != st.lua_release || got.path_len != st.path_len)
+        return {};
+    std::string p(got.path_len, '\0');
+    if (!in.read(p.data(), static_cast<std::streamsize>(p.size())) || p != path) return {};
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+int collect(lua_State*, const void* p, size_t sz, void* ud) {
+    auto* out = static_cast<std::vector<char>*>(ud);
+    out->insert(out->end(), static_cast<const char*>(p), static_cast<const char*>(p) + sz);
+    return 0;
+}
+
+// Dump the chunk on top of L next to its stamp; written aside and renamed so
+// a crash never leaves a torn entry.
+void write_entry(lua_State* L, const fs::path& file, const Stamp& st, const std::string& path) {
+    std::vector<char> code;
+    if (lua_dump(L, collect, &code, 0) != 0 || code.empty()) return;
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+    fs::path tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(MAGIC, sizeof(MAGIC));
+        out.write(reinterpret_cast<const char*>(&st), sizeof(st));
+        out.write(path.data(), static_cast<std::streamsize>(path.size()));
+        out.write(code.data(), static_cast<std::streamsize>(code.size()));
+        if (!out) return;
+    }
+    fs::rename(tmp, file, ec);
+    if (ec) {
+        std::fprintf(stderr, "[lua] bytecode cache: can't write %s: %s\n", file.string().c_str(), ec.message().c_str());
+        fs::remove(tmp, ec);
+    }
+}
+
+} // namespace
+
+int BytecodeCache::load(lua_State* L, const std::string& path) {
+    const std::string chunkname = "@" + path; // same name as a source load, so errors read the same
+    Stamp st{};
+    const bool cacheable = enabled && stamp_of(path, st);
+    fs::path file;
+    if (cacheable) {
+        file = entry_for(dir, path);
+        std::vector<char> code = read_entry(file, st, path);
+        if (!code.empty()) {
+            if (luaL_loadbufferx(L, code.data(), code.size(), chunkname.c_str(), "b") == LUA_OK) {
+                ++hits;
+                return LUA_OK;
+            }
+            lua_pop(L, 1); // stale or foreign bytecode: fall back to source
+        }
+    }
+    ++misses;
+    int status = luaL_loadfilex(L, path.c_str(), "t");
+    if (status == LUA_OK && cacheable) write_entry(L, file, st, path);
+    return status;
+}
@@ -0,0 +1,22 @@
+// Bytecode cache for mod scripts.
+// Responsibility: load a script as a compiled chunk, from a lua_dump copy
+// under `dir` when it still matches the source, else from source (and
+// refresh the copy).
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+struct lua_State;
+
+struct BytecodeCache {
+    std::string dir{"cache/luac"};
+    bool enabled{true};
+    // Per load_mods pass
+    std::size_t hits{0};
+    std::size_t misses{0};
+
+    // Pushes the chunk onto L (or an error message) and returns the Lua
+    // status. A copy is valid if path, mtime, size and Lua release match.
+    int load(lua_State* L, const std::string& path);
+};
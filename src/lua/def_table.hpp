@@ -0,0 +1,84 @@
+// Definition table keyed by Lua `type` id.
+// Responsibility: own one kind of mod definition in registration order and
+// map type ids to dense indices at load time, so lookups are O(1).
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+template <typename Def>
+struct DefTable {
+  public:
+    // Registering a type twice keeps both defs; lookups see the first.
+    void add(const Def& d) {
+        auto idx = static_cast<std::uint32_t>(defs.size());
+        defs.push_back(d);
+        if (index_of(d.type) < 0)
+            index(d.type, idx);
+    }
+
+    // Index into all(), or -1 if no def has this type.
+    std::int32_t index_of(int type) const {
+        std::int64_t k = static_cast<std::int64_t>(type) - base;
+        if (k >= 0 && k < static_cast<std::int64_t>(slots.size()))
+            return static_cast<std::int32_t>(slots[static_cast<std::size_t>(k)]) - 1;
+        auto it = sparse.find(type);
+        return it == sparse.end() ? -1 : static_cast<std::int32_t>(it->second);
+    }
+    const Def* find(int type) const {
+        std::int32_t i = index_of(type);
+        return i < 0 ? nullptr : &defs[static_cast<std::size_t>(i)];
+    }
+
+    const std::vector<Def>& all() const {
+        return defs;
+    }
+    // For load-time passes that fill derived fields (see LuaManager::link);
+    // must not add, remove or retype defs.
+    std::vector<Def>& all_mut() {
+        return defs;
+    }
+    std::size_t size() const {
+        return defs.size();
+    }
+    void clear() {
+        defs.clear();
+        slots.clear();
+        sparse.clear();
+        base = 0;
+    }
+
+  private:
+    // Widest type range indexed directly; types that would stretch it further
+    // go to `sparse`. Mods number each kind in a tight block (100s, 200s...).
+    static constexpr std::int64_t MAX_SPAN = 1 << 16;
+
+    void index(int type, std::uint32_t idx) {
+        std::int64_t t = type;
+        if (slots.empty()) {
+            base = t;
+            slots.assign(1, 0);
+        }
+        std::int64_t lo = std::min(base, t);
+        std::int64_t hi = std::max(base + static_cast<std::int64_t>(slots.size()) - 1, t);
+        if (hi - lo + 1 > MAX_SPAN) {
+            sparse.emplace(type, idx);
+            return;
+        }
+        if (t < base) {
+            slots.insert(slots.begin(), static_cast<std::size_t>(base - t), 0);
+            base = t;
+        } else if (t - base >= static_cast<std::int64_t>(slots.size())) {
+            slots.resize(static_cast<std::size_t>(t - base + 1), 0);
+        }
+        slots[static_cast<std::size_t>(t - base)] = idx + 1;
+    }
+
+    std::vector<Def> defs;
+    std::vector<std::uint32_t> slots; // type - base => index + 1; 0 => none
+    std::int64_t base{0};
+    std::unordered_map<int, std::uint32_t> sparse;
+};
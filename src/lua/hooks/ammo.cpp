@@ -4,22 +4,25 @@
 #include <sol/sol.hpp>
 
 void LuaManager::call_ammo_on_hit(int ammo_type) {
-    auto it = hooks_->ammo.find(ammo_type);
-    if (it == hooks_->ammo.end() || !it->second.on_hit.valid()) return;
-    auto r = it->second.on_hit();
-    if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] ammo on_hit error: %s\n", e.what()); }
+    auto* h = hook_slot(ammo_, hooks_->ammo_table, ammo_type, AMMO_HOOK_ON_HIT);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_hit();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "ammo on_hit", e.what()); }
 }
 
 void LuaManager::call_ammo_on_hit_entity(int ammo_type) {
-    auto it2 = hooks_->ammo.find(ammo_type);
-    if (it2 == hooks_->ammo.end() || !it2->second.on_hit_entity.valid()) return;
-    auto r = it2->second.on_hit_entity();
-    if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] ammo on_hit_entity error: %s\n", e.what()); }
+    auto* h = hook_slot(ammo_, hooks_->ammo_table, ammo_type, AMMO_HOOK_ON_HIT_ENTITY);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_hit_entity();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "ammo on_hit_entity", e.what()); }
 }
 
 void LuaManager::call_ammo_on_hit_tile(int ammo_type) {
-    auto it3 = hooks_->ammo.find(ammo_type);
-    if (it3 == hooks_->ammo.end() || !it3->second.on_hit_tile.valid()) return;
-    auto r = it3->second.on_hit_tile();
-    if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] ammo on_hit_tile error: %s\n", e.what()); }
+    auto* h = hook_slot(ammo_, hooks_->ammo_table, ammo_type, AMMO_HOOK_ON_HIT_TILE);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_hit_tile();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "ammo on_hit_tile", e.what()); }
 }
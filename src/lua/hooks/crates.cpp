@@ -5,12 +5,9 @@
 
 void LuaManager::call_crate_on_open(int crate_type, Entity& player) {
     (void)player;
-    auto it = hooks_->crates.find(crate_type);
-    for (auto const& c : crates_) if (c.type == crate_type) {
-        if (it != hooks_->crates.end() && it->second.on_open.valid()) {
-            auto r = it->second.on_open();
-            if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] crate on_open error: %s\n", e.what()); }
-        }
-        break;
-    }
+    auto* h = hook_slot(crates_, hooks_->crate_table, crate_type, CRATE_HOOK_ON_OPEN);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_open();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "crate on_open", e.what()); }
 }
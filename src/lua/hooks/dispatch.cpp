@@ -0,0 +1,155 @@
+#include "luamgr.hpp"
+// hooks: compile staged hook maps into per-def dispatch tables
+#include "lua/internal_state.hpp"
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+template <typename Hooks>
+struct HookField {
+    std::uint32_t bit;
+    sol::protected_function Hooks::*fn;
+};
+
+constexpr HookField<ItemHooks> ITEM_FIELDS[] = {
+    {ITEM_HOOK_ON_USE, &ItemHooks::on_use},
+    {ITEM_HOOK_ON_TICK, &ItemHooks::on_tick},
+    {ITEM_HOOK_ON_SHOOT, &ItemHooks::on_shoot},
+    {ITEM_HOOK_ON_DAMAGE, &ItemHooks::on_damage},
+    {ITEM_HOOK_ON_ACTIVE_RELOAD, &ItemHooks::on_active_reload},
+    {ITEM_HOOK_ON_FAILED_ACTIVE_RELOAD, &ItemHooks::on_failed_active_reload},
+    {ITEM_HOOK_ON_TRIED_AFTER_FAILED_AR, &ItemHooks::on_tried_after_failed_ar},
+    {ITEM_HOOK_ON_PICKUP, &ItemHooks::on_pickup},
+    {ITEM_HOOK_ON_DROP, &ItemHooks::on_drop},
+    {ITEM_HOOK_ON_EJECT, &ItemHooks::on_eject},
+    {ITEM_HOOK_ON_RELOAD_START, &ItemHooks::on_reload_start},
+    {ITEM_HOOK_ON_RELOAD_FINISH, &ItemHooks::on_reload_finish},
+};
+
+constexpr HookField<GunHooks> GUN_FIELDS[] = {
+    {GUN_HOOK_ON_JAM, &GunHooks::on_jam},
+    {GUN_HOOK_ON_ACTIVE_RELOAD, &GunHooks::on_active_reload},
+    {GUN_HOOK_ON_FAILED_ACTIVE_RELOAD, &GunHooks::on_failed_active_reload},
+    {GUN_HOOK_ON_TRIED_AFTER_FAILED_AR, &GunHooks::on_tried_after_failed_ar},
+    {GUN_HOOK_ON_PICKUP, &GunHooks::on_pickup},
+    {GUN_HOOK_ON_DROP, &GunHooks::on_drop},
+    {GUN_HOOK_ON_STEP, &GunHooks::on_step},
+    {GUN_HOOK_ON_EJECT, &GunHooks::on_eject},
+    {GUN_HOOK_ON_RELOAD_START, &GunHooks::on_reload_start},
+    {GUN_HOOK_ON_RELOAD_FINISH, &GunHooks::on_reload_finish},
+};
+
+constexpr HookField<AmmoHooks> AMMO_FIELDS[] = {
+    {AMMO_HOOK_ON_HIT, &AmmoHooks::on_hit},
+    {AMMO_HOOK_ON_HIT_ENTITY, &AmmoHooks::on_hit_entity},
+    {AMMO_HOOK_ON_HIT_TILE, &AmmoHooks::on_hit_tile},
+};
+
+constexpr HookField<ProjectileHooks> PROJECTILE_FIELDS[] = {
+    {PROJECTILE_HOOK_ON_HIT_ENTITY, &ProjectileHooks::on_hit_entity},
+    {PROJECTILE_HOOK_ON_HIT_TILE, &ProjectileHooks::on_hit_tile},
+};
+
+constexpr HookField<CrateHooks> CRATE_FIELDS[] = {
+    {CRATE_HOOK_ON_OPEN, &CrateHooks::on_open},
+};
+
+constexpr HookField<EntityHooks> ENTITY_FIELDS[] = {
+    {ENTITY_HOOK_ON_STEP, &EntityHooks::on_step},
+    {ENTITY_HOOK_ON_DAMAGE, &EntityHooks::on_damage},
+    {ENTITY_HOOK_ON_SPAWN, &EntityHooks::on_spawn},
+    {ENTITY_HOOK_ON_DEATH, &EntityHooks::on_death},
+    {ENTITY_HOOK_ON_RELOAD_START, &EntityHooks::on_reload_start},
+    {ENTITY_HOOK_ON_RELOAD_FINISH, &EntityHooks::on_reload_finish},
+    {ENTITY_HOOK_ON_GUN_JAM, &EntityHooks::on_gun_jam},
+    {ENTITY_HOOK_ON_OUT_OF_AMMO, &EntityHooks::on_out_of_ammo},
+    {ENTITY_HOOK_ON_HP_UNDER_50, &EntityHooks::on_hp_under_50},
+    {ENTITY_HOOK_ON_HP_UNDER_25, &EntityHooks::on_hp_under_25},
+    {ENTITY_HOOK_ON_HP_FULL, &EntityHooks::on_hp_full},
+    {ENTITY_HOOK_ON_SHIELD_UNDER_50, &EntityHooks::on_shield_under_50},
+    {ENTITY_HOOK_ON_SHIELD_UNDER_25, &EntityHooks::on_shield_under_25},
+    {ENTITY_HOOK_ON_SHIELD_FULL, &EntityHooks::on_shield_full},
+    {ENTITY_HOOK_ON_PLATES_LOST, &EntityHooks::on_plates_lost},
+    {ENTITY_HOOK_ON_COLLIDE_TILE, &EntityHooks::on_collide_tile},
+    {ENTITY_HOOK_ON_STEP_BATCH, &EntityHooks::on_step_batch},
+};
+
+// Move each staged hook set to its def's slot and record which callbacks it
+// has. Hooks without a def are dropped, as before (no def, no dispatch).
+template <typename Def, typename Hooks, std::size_t N>
+void compile(DefTable<Def>& defs, std::unordered_map<int, Hooks>& staged, std::vector<Hooks>& table,
+             const HookField<Hooks> (&fields)[N]) {
+    table.assign(defs.size(), Hooks{});
+    auto& all = defs.all_mut();
+    for (std::size_t k = 0; k < all.size(); ++k) {
+        all[k].hooks = 0;
+        table[k].stats.type = all[k].type;
+    }
+    for (auto& [type, h] : staged) {
+        std::int32_t i = defs.index_of(type);
+        if (i < 0) continue;
+        auto k = static_cast<std::size_t>(i);
+        std::uint32_t mask = 0;
+        for (const auto& f : fields)
+            if ((h.*f.fn).valid()) mask |= f.bit;
+        all[k].hooks = mask;
+        table[k] = std::move(h);
+        table[k].stats.type = all[k].type;
+    }
+    staged.clear();
+}
+
+struct StatsRow {
+    const char* kind;
+    const std::string* name;
+    const HookStats* stats;
+};
+
+template <typename Def, typename Hooks>
+void collect(std::vector<StatsRow>& rows, const char* kind, const DefTable<Def>& defs, const std::vector<Hooks>& table) {
+    for (std::size_t k = 0; k < table.size() && k < defs.size(); ++k)
+        if (table[k].stats.calls > 0) rows.push_back({kind, &defs.all()[k].name, &table[k].stats});
+}
+
+} // namespace
+
+void LuaManager::log_hook_stats(std::size_t top) const {
+    if (!hooks_) return;
+    std::vector<StatsRow> rows;
+    collect(rows, "item", items_, hooks_->item_table);
+    collect(rows, "gun", guns_, hooks_->gun_table);
+    collect(rows, "ammo", ammo_, hooks_->ammo_table);
+    collect(rows, "projectile", projectiles_, hooks_->projectile_table);
+    collect(rows, "crate", crates_, hooks_->crate_table);
+    collect(rows, "entity", entity_types_, hooks_->entity_table);
+    static const std::string global_name = "(global hooks)", timer_name = "(timers)";
+    if (hooks_->global.stats.calls > 0) rows.push_back({"global", &global_name, &hooks_->global.stats});
+    if (timers_ && timers_->stats.calls > 0) rows.push_back({"timer", &timer_name, &timers_->stats});
+    if (rows.empty()) return;
+    std::sort(rows.begin(), rows.end(), [](const StatsRow& a, const StatsRow& b) {
+        if (a.stats->aborts != b.stats->aborts) return a.stats->aborts > b.stats->aborts;
+        return a.stats->instructions > b.stats->instructions;
+    });
+    std::printf("[lua] hook stats (top %zu of %zu):\n", std::min(top, rows.size()), rows.size());
+    for (std::size_t i = 0; i < rows.size() && i < top; ++i) {
+        const HookStats& s = *rows[i].stats;
+        std::printf("[lua]   %-10s %-24s type %-6d calls %-10llu instr ~%-12llu aborts %llu\n", rows[i].kind,
+                    rows[i].name->c_str(), s.type, static_cast<unsigned long long>(s.calls),
+                    static_cast<unsigned long long>(s.instructions), static_cast<unsigned long long>(s.aborts));
+    }
+}
+
+void LuaManager::compile_hooks() {
+    if (!hooks_) return;
+    compile(items_, hooks_->items, hooks_->item_table, ITEM_FIELDS);
+    compile(guns_, hooks_->guns, hooks_->gun_table, GUN_FIELDS);
+    compile(ammo_, hooks_->ammo, hooks_->ammo_table, AMMO_FIELDS);
+    compile(projectiles_, hooks_->projectiles, hooks_->projectile_table, PROJECTILE_FIELDS);
+    compile(crates_, hooks_->crates, hooks_->crate_table, CRATE_FIELDS);
+    compile(entity_types_, hooks_->entities, hooks_->entity_table, ENTITY_FIELDS);
+}
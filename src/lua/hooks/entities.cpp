@@ -6,129 +6,143 @@
 // hooks: entities
 
 void LuaManager::call_entity_on_step(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it = hooks_->entities.find(entity_type);
-    if (!ed || it == hooks_->entities.end() || !it->second.on_step.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_STEP);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it->second.on_step(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_step error: %s\n", er.what()); }
+    auto r = h->on_step(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_step", er.what()); }
+}
+
+void LuaManager::call_entity_on_step_batch(int entity_type, const VID* vids, std::size_t n) {
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_STEP_BATCH);
+    if (!h || !S || n == 0) return;
+    LuaWatch _watch(h->stats);
+    sol::table& arr = hooks_->step_batch;
+    if (!arr.valid()) arr = S->create_table(static_cast<int>(n), 0);
+    for (std::size_t i = 0; i < n; ++i) arr.raw_set(i + 1, entity_handle(vids[i]));
+    for (std::size_t i = n + 1; i <= hooks_->step_batch_len; ++i) arr.raw_set(i, sol::lua_nil);
+    hooks_->step_batch_len = n;
+    // No implicit entity; the script picks one per handle with api.use_entity
+    LuaCtxGuard _ctx(ss, nullptr);
+    auto r = h->on_step_batch(arr); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_step_batch", er.what()); }
 }
 
 void LuaManager::call_entity_on_damage(int entity_type, Entity& e, int attacker_ap) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it2 = hooks_->entities.find(entity_type);
-    if (!ed || it2 == hooks_->entities.end() || !it2->second.on_damage.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_DAMAGE);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it2->second.on_damage(attacker_ap); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_damage error: %s\n", er.what()); }
+    auto r = h->on_damage(attacker_ap); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_damage", er.what()); }
 }
 
 void LuaManager::call_entity_on_spawn(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it3 = hooks_->entities.find(entity_type);
-    if (!ed || it3 == hooks_->entities.end() || !it3->second.on_spawn.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_SPAWN);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it3->second.on_spawn(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_spawn error: %s\n", er.what()); }
+    auto r = h->on_spawn(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_spawn", er.what()); }
 }
 
 void LuaManager::call_entity_on_death(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it4 = hooks_->entities.find(entity_type);
-    if (!ed || it4 == hooks_->entities.end() || !it4->second.on_death.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_DEATH);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it4->second.on_death(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_death error: %s\n", er.what()); }
+    auto r = h->on_death(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_death", er.what()); }
 }
 
 void LuaManager::call_entity_on_reload_start(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it5 = hooks_->entities.find(entity_type);
-    if (!ed || it5 == hooks_->entities.end() || !it5->second.on_reload_start.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_RELOAD_START);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it5->second.on_reload_start(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_reload_start error: %s\n", er.what()); }
+    auto r = h->on_reload_start(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_reload_start", er.what()); }
 }
 
 void LuaManager::call_entity_on_reload_finish(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it6 = hooks_->entities.find(entity_type);
-    if (!ed || it6 == hooks_->entities.end() || !it6->second.on_reload_finish.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_RELOAD_FINISH);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it6->second.on_reload_finish(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_reload_finish error: %s\n", er.what()); }
+    auto r = h->on_reload_finish(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_reload_finish", er.what()); }
 }
 
 void LuaManager::call_entity_on_gun_jam(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it7 = hooks_->entities.find(entity_type);
-    if (!ed || it7 == hooks_->entities.end() || !it7->second.on_gun_jam.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_GUN_JAM);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it7->second.on_gun_jam(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_gun_jam error: %s\n", er.what()); }
+    auto r = h->on_gun_jam(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_gun_jam", er.what()); }
 }
 
 void LuaManager::call_entity_on_out_of_ammo(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it8 = hooks_->entities.find(entity_type);
-    if (!ed || it8 == hooks_->entities.end() || !it8->second.on_out_of_ammo.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_OUT_OF_AMMO);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it8->second.on_out_of_ammo(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_out_of_ammo error: %s\n", er.what()); }
+    auto r = h->on_out_of_ammo(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_out_of_ammo", er.what()); }
 }
 
 void LuaManager::call_entity_on_hp_under_50(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it9 = hooks_->entities.find(entity_type);
-    if (!ed || it9 == hooks_->entities.end() || !it9->second.on_hp_under_50.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_HP_UNDER_50);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it9->second.on_hp_under_50(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_hp_under_50 error: %s\n", er.what()); }
+    auto r = h->on_hp_under_50(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_hp_under_50", er.what()); }
 }
 
 void LuaManager::call_entity_on_hp_under_25(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it10 = hooks_->entities.find(entity_type);
-    if (!ed || it10 == hooks_->entities.end() || !it10->second.on_hp_under_25.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_HP_UNDER_25);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it10->second.on_hp_under_25(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_hp_under_25 error: %s\n", er.what()); }
+    auto r = h->on_hp_under_25(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_hp_under_25", er.what()); }
 }
 
 void LuaManager::call_entity_on_hp_full(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it11 = hooks_->entities.find(entity_type);
-    if (!ed || it11 == hooks_->entities.end() || !it11->second.on_hp_full.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_HP_FULL);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it11->second.on_hp_full(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_hp_full error: %s\n", er.what()); }
+    auto r = h->on_hp_full(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_hp_full", er.what()); }
 }
 
 void LuaManager::call_entity_on_shield_under_50(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it12 = hooks_->entities.find(entity_type);
-    if (!ed || it12 == hooks_->entities.end() || !it12->second.on_shield_under_50.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_SHIELD_UNDER_50);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it12->second.on_shield_under_50(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_shield_under_50 error: %s\n", er.what()); }
+    auto r = h->on_shield_under_50(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_shield_under_50", er.what()); }
 }
 
 void LuaManager::call_entity_on_shield_under_25(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it13 = hooks_->entities.find(entity_type);
-    if (!ed || it13 == hooks_->entities.end() || !it13->second.on_shield_under_25.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_SHIELD_UNDER_25);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it13->second.on_shield_under_25(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_shield_under_25 error: %s\n", er.what()); }
+    auto r = h->on_shield_under_25(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_shield_under_25", er.what()); }
 }
 
 void LuaManager::call_entity_on_shield_full(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it14 = hooks_->entities.find(entity_type);
-    if (!ed || it14 == hooks_->entities.end() || !it14->second.on_shield_full.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_SHIELD_FULL);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it14->second.on_shield_full(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_shield_full error: %s\n", er.what()); }
+    auto r = h->on_shield_full(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_shield_full", er.what()); }
 }
 
 void LuaManager::call_entity_on_plates_lost(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it15 = hooks_->entities.find(entity_type);
-    if (!ed || it15 == hooks_->entities.end() || !it15->second.on_plates_lost.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_PLATES_LOST);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it15->second.on_plates_lost(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_plates_lost error: %s\n", er.what()); }
+    auto r = h->on_plates_lost(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_plates_lost", er.what()); }
 }
 
 void LuaManager::call_entity_on_collide_tile(int entity_type, Entity& e) {
-    const EntityTypeDef* ed = find_entity_type(entity_type);
-    auto it16 = hooks_->entities.find(entity_type);
-    if (!ed || it16 == hooks_->entities.end() || !it16->second.on_collide_tile.valid()) return;
+    auto* h = hook_slot(entity_types_, hooks_->entity_table, entity_type, ENTITY_HOOK_ON_COLLIDE_TILE);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
     LuaCtxGuard _ctx(ss, &e);
-    auto r = it16->second.on_collide_tile(); if (!r.valid()) { sol::error er = r; std::fprintf(stderr, "[lua] entity on_collide_tile error: %s\n", er.what()); }
+    auto r = h->on_collide_tile(); if (!r.valid()) { sol::error er = r; lua_hook_error(_watch, "entity on_collide_tile", er.what()); }
 }
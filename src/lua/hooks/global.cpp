@@ -7,69 +7,77 @@
 
 void LuaManager::call_on_dash(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
+    LuaWatch _watch(hooks_->global.stats);
     if (hooks_->global.on_dash.valid()) {
-        auto r = hooks_->global.on_dash(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_dash error: %s\n", e.what()); }
+        auto r = hooks_->global.on_dash(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_dash", e.what()); }
     } else {
         sol::object obj = S->get<sol::object>("on_dash");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_dash error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_dash", e.what()); } }
     }
 }
 
 void LuaManager::call_on_step(Entity* player) {
     LuaCtxGuard _ctx(ss, player);
-    if (hooks_->global.on_step.valid()) { auto r = hooks_->global.on_step(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_step error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_step.valid()) { auto r = hooks_->global.on_step(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_step", e.what()); } }
 }
 
 void LuaManager::call_on_active_reload(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_active_reload.valid()) { auto r = hooks_->global.on_active_reload(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_active_reload error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_active_reload.valid()) { auto r = hooks_->global.on_active_reload(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_active_reload", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_active_reload");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_active_reload error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_active_reload", e.what()); } }
     }
 }
 
 void LuaManager::call_on_failed_active_reload(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_failed_active_reload.valid()) { auto r = hooks_->global.on_failed_active_reload(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_failed_active_reload error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_failed_active_reload.valid()) { auto r = hooks_->global.on_failed_active_reload(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_failed_active_reload", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_failed_active_reload");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_failed_active_reload error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_failed_active_reload", e.what()); } }
     }
 }
 
 void LuaManager::call_on_tried_after_failed_ar(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_tried_after_failed_ar.valid()) { auto r = hooks_->global.on_tried_after_failed_ar(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_tried_to_active_reload_after_failing error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_tried_after_failed_ar.valid()) { auto r = hooks_->global.on_tried_after_failed_ar(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_tried_to_active_reload_after_failing", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_tried_to_active_reload_after_failing");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_tried_to_active_reload_after_failing error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_tried_to_active_reload_after_failing", e.what()); } }
     }
 }
 
 void LuaManager::call_on_eject(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_eject.valid()) { auto r = hooks_->global.on_eject(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_eject error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_eject.valid()) { auto r = hooks_->global.on_eject(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_eject", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_eject");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_eject error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_eject", e.what()); } }
     }
 }
 
 void LuaManager::call_on_reload_start(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_reload_start.valid()) { auto r = hooks_->global.on_reload_start(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_reload_start error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_reload_start.valid()) { auto r = hooks_->global.on_reload_start(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_reload_start", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_reload_start");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_reload_start error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_reload_start", e.what()); } }
     }
 }
 
 void LuaManager::call_on_reload_finish(Entity& player) {
     LuaCtxGuard _ctx(ss, &player);
-    if (hooks_->global.on_reload_finish.valid()) { auto r = hooks_->global.on_reload_finish(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_reload_finish error: %s\n", e.what()); } }
+    LuaWatch _watch(hooks_->global.stats);
+    if (hooks_->global.on_reload_finish.valid()) { auto r = hooks_->global.on_reload_finish(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_reload_finish", e.what()); } }
     else {
         sol::object obj = S->get<sol::object>("on_reload_finish");
-        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] on_reload_finish error: %s\n", e.what()); } }
+        if (obj.is<sol::function>()) { auto r = obj.as<sol::protected_function>()(); if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "on_reload_finish", e.what()); } }
     }
 }
@@ -4,15 +4,17 @@
 #include <sol/sol.hpp>
 
 void LuaManager::call_projectile_on_hit_entity(int proj_type) {
-    auto it = hooks_->projectiles.find(proj_type);
-    if (it == hooks_->projectiles.end() || !it->second.on_hit_entity.valid()) return;
-    auto r = it->second.on_hit_entity();
-    if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] projectile on_hit_entity error: %s\n", e.what()); }
+    auto* h = hook_slot(projectiles_, hooks_->projectile_table, proj_type, PROJECTILE_HOOK_ON_HIT_ENTITY);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_hit_entity();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "projectile on_hit_entity", e.what()); }
 }
 
 void LuaManager::call_projectile_on_hit_tile(int proj_type) {
-    auto it2 = hooks_->projectiles.find(proj_type);
-    if (it2 == hooks_->projectiles.end() || !it2->second.on_hit_tile.valid()) return;
-    auto r = it2->second.on_hit_tile();
-    if (!r.valid()) { sol::error e = r; std::fprintf(stderr, "[lua] projectile on_hit_tile error: %s\n", e.what()); }
+    auto* h = hook_slot(projectiles_, hooks_->projectile_table, proj_type, PROJECTILE_HOOK_ON_HIT_TILE);
+    if (!h) return;
+    LuaWatch _watch(h->stats);
+    auto r = h->on_hit_tile();
+    if (!r.valid()) { sol::error e = r; lua_hook_error(_watch, "projectile on_hit_tile", e.what()); }
 }
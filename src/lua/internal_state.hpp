@@ -1,7 +1,16 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <unordered_map>
+#include <vector>
 #include <sol/sol.hpp>
+#include "lua/def_table.hpp"
+#include "lua/lua_defs.hpp"
+#include "lua/watchdog.hpp"
+#include "types.hpp"
 
 struct ItemHooks {
     sol::protected_function on_use;
@@ -16,6 +25,7 @@ struct ItemHooks {
     sol::protected_function on_eject;
     sol::protected_function on_reload_start;
     sol::protected_function on_reload_finish;
+    HookStats stats;
 };
 
 struct GunHooks {
@@ -29,20 +39,26 @@ struct GunHooks {
     sol::protected_function on_eject;
     sol::protected_function on_reload_start;
     sol::protected_function on_reload_finish;
+    HookStats stats;
 };
 
 struct AmmoHooks {
     sol::protected_function on_hit;
     sol::protected_function on_hit_entity;
     sol::protected_function on_hit_tile;
+    HookStats stats;
 };
 
 struct ProjectileHooks {
     sol::protected_function on_hit_entity;
     sol::protected_function on_hit_tile;
+    HookStats stats;
 };
 
-struct CrateHooks { sol::protected_function on_open; };
+struct CrateHooks {
+    sol::protected_function on_open;
+    HookStats stats;
+};
 
 struct EntityHooks {
     sol::protected_function on_step;
@@ -61,6 +77,10 @@ struct EntityHooks {
     sol::protected_function on_shield_full;
     sol::protected_function on_plates_lost;
     sol::protected_function on_collide_tile;
+    // Opt-in: once per type per tick phase with every due entity, in place
+    // of per-entity on_step calls.
+    sol::protected_function on_step_batch;
+    HookStats stats;
 };
 
 struct GlobalHooks {
@@ -72,15 +92,71 @@ struct GlobalHooks {
     sol::protected_function on_eject;
     sol::protected_function on_reload_start;
     sol::protected_function on_reload_finish;
+    HookStats stats;
 };
 
 struct LuaHooks {
+    // Staging: filled by registration while scripts load (last one wins),
+    // then moved into the *_table vectors by LuaManager::compile_hooks().
     std::unordered_map<int, ItemHooks> items;
     std::unordered_map<int, GunHooks> guns;
     std::unordered_map<int, AmmoHooks> ammo;
     std::unordered_map<int, ProjectileHooks> projectiles;
     std::unordered_map<int, CrateHooks> crates;
     std::unordered_map<int, EntityHooks> entities;
+    // Dispatch: one slot per def, same index as the owning DefTable.
+    std::vector<ItemHooks> item_table;
+    std::vector<GunHooks> gun_table;
+    std::vector<AmmoHooks> ammo_table;
+    std::vector<ProjectileHooks> projectile_table;
+    std::vector<CrateHooks> crate_table;
+    std::vector<EntityHooks> entity_table;
     GlobalHooks global;
+    // Array handed to on_step_batch; reused across calls, step_batch_len
+    // tracks how much of it is filled.
+    sol::table step_batch;
+    std::size_t step_batch_len{0};
 };
 
+// Hooks for `type` if its def has `bit` set in its hooks mask, else nullptr.
+template <typename Def, typename Hooks>
+Hooks* hook_slot(const DefTable<Def>& defs, std::vector<Hooks>& table, int type, std::uint32_t bit) {
+    std::int32_t i = defs.index_of(type);
+    if (i < 0) return nullptr;
+    auto k = static_cast<std::size_t>(i);
+    if (k >= table.size() || !(defs.all()[k].hooks & bit)) return nullptr;
+    return &table[k];
+}
+
+
+// api.after/api.every timer. The body runs as a coroutine so it may wait().
+struct LuaTimer {
+    sol::protected_function fn;
+    sol::thread thread; // set while the body is suspended in wait()
+    sol::coroutine co;
+    std::uint64_t due{0};    // timer tick of the next resume
+    std::uint32_t period{0}; // ticks between runs; 0 => one-shot
+    std::uint32_t gen{0};    // bumped on reuse; stale handles miss
+    VID owner{};             // hook entity at creation; its death cancels
+    bool has_owner{false};
+    int inst_kind{0};        // INV_GUN/INV_ITEM: started by that instance's tick
+    VID inst{};              // ...which must still exist and be carried
+
+    std::uint16_t mod{0};    // LuaMemory owner at creation
+    bool live{false};
+    bool cancelled{false};
+    TickPhase phase{TICK_AFTER_PHYSICS};
+};
+
+// Hashed timing wheel per tick phase, one slot per fixed step. A live timer
+// sits in exactly one slot (except while running); timers more than a lap
+// out are skipped until their lap comes round.
+struct LuaTimers {
+    static constexpr std::size_t WHEEL = 256;
+    std::deque<LuaTimer> timers; // deque: stable while a resume adds more
+    std::vector<std::uint32_t> free_ids;
+    std::array<std::array<std::vector<std::uint32_t>, WHEEL>, TICK_PHASE_COUNT> wheel{};
+    std::array<std::uint64_t, TICK_PHASE_COUNT> now{};
+    std::vector<std::uint32_t> scratch;
+    HookStats stats; // all timer bodies
+};
@@ -0,0 +1,68 @@
+#include "luamgr.hpp"
+// link: resolve def sprite/sound keys to handles after loading
+#include "audio.hpp"
+#include "globals.hpp"
+#include "graphics.hpp"
+
+#include <cstdio>
+
+namespace {
+
+struct Linker {
+    bool check_sounds{false}; // sounds aren't loaded headless; don't flag them then
+    std::size_t unresolved{0};
+
+    void report(const char* kind, const std::string& owner, const char* what, const std::string& key) {
+        std::fprintf(stderr, "[lua] %s '%s': unknown %s '%s'\n", kind, owner.c_str(), what, key.c_str());
+        unresolved += 1;
+    }
+    int sprite(const char* kind, const std::string& owner, const std::string& key) {
+        if (key.empty()) return -1;
+        int id = (key.find(':') != std::string::npos) ? try_get_sprite_id(key) : -1;
+        if (id < 0) report(kind, owner, "sprite", key);
+        return id;
+    }
+    int sound(const char* kind, const std::string& owner, const std::string& key) {
+        if (key.empty()) return -1;
+        int id = try_get_sound_id(key);
+        if (id < 0 && check_sounds) report(kind, owner, "sound", key);
+        return id;
+    }
+    // An empty key takes the engine default; a named one that is missing
+    // stays silent at play time, as before.
+    int sound(const char* kind, const std::string& owner, const std::string& key, SymKey fallback) {
+        return key.empty() ? try_get_sound_id(fallback) : sound(kind, owner, key);
+    }
+};
+
+} // namespace
+
+std::size_t LuaManager::link() {
+    if (!gg) return 0;
+    Linker k;
+    k.check_sounds = aa && !aa->chunks.empty();
+    for (auto& d : powerups_.all_mut())
+        d.sprite_id = k.sprite("powerup", d.name, d.sprite);
+    for (auto& d : items_.all_mut()) {
+        d.sprite_id = k.sprite("item", d.name, d.sprite);
+        d.sound_use_id = k.sound("item", d.name, d.sound_use);
+        d.sound_pickup_id = k.sound("item", d.name, d.sound_pickup, "base:drop"_sym);
+    }
+    for (auto& d : guns_.all_mut()) {
+        d.sprite_id = k.sprite("gun", d.name, d.sprite);
+        d.sound_fire_id = k.sound("gun", d.name, d.sound_fire, "base:small_shoot"_sym);
+        d.sound_reload_id = k.sound("gun", d.name, d.sound_reload, "base:reload"_sym);
+        d.sound_jam_id = k.sound("gun", d.name, d.sound_jam, "base:ui_cant"_sym);
+        d.sound_pickup_id = k.sound("gun", d.name, d.sound_pickup, "base:drop"_sym);
+    }
+    for (auto& d : projectiles_.all_mut())
+        d.sprite_id = k.sprite("projectile", d.name, d.sprite);
+    for (auto& d : ammo_.all_mut())
+        d.sprite_id = k.sprite("ammo", d.name, d.sprite);
+    for (auto& d : entity_types_.all_mut())
+        d.sprite_id = k.sprite("entity type", d.name, d.sprite);
+    if (k.unresolved)
+        std::fprintf(stderr, "[lua] %zu unresolved sprite/sound reference(s)\n", k.unresolved);
+    unresolved_refs_ = k.unresolved;
+    return k.unresolved;
+}
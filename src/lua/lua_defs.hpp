@@ -1,15 +1,87 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 // Plain data structs used by mods. Keep sol types here so other headers
 // don’t need to include sol directly.
+// Fields ending in _id are sprite/sound handles filled in by
+// LuaManager::link() after loading; -1 => unset or unresolved.
+
+// When a def's Lua tick runs relative to physics.
+enum TickPhase : std::uint8_t { TICK_BEFORE_PHYSICS = 0, TICK_AFTER_PHYSICS = 1, TICK_PHASE_COUNT };
+
+inline TickPhase tick_phase_from(const std::string& s) {
+    return s == "before" ? TICK_BEFORE_PHYSICS : TICK_AFTER_PHYSICS;
+}
+
+// Hook presence bits for the `hooks` mask on defs; one per Lua callback.
+// Set by LuaManager::compile_hooks() after loading.
+enum ItemHook : std::uint32_t {
+    ITEM_HOOK_ON_USE = 1u << 0,
+    ITEM_HOOK_ON_TICK = 1u << 1,
+    ITEM_HOOK_ON_SHOOT = 1u << 2,
+    ITEM_HOOK_ON_DAMAGE = 1u << 3,
+    ITEM_HOOK_ON_ACTIVE_RELOAD = 1u << 4,
+    ITEM_HOOK_ON_FAILED_ACTIVE_RELOAD = 1u << 5,
+    ITEM_HOOK_ON_TRIED_AFTER_FAILED_AR = 1u << 6,
+    ITEM_HOOK_ON_PICKUP = 1u << 7,
+    ITEM_HOOK_ON_DROP = 1u << 8,
+    ITEM_HOOK_ON_EJECT = 1u << 9,
+    ITEM_HOOK_ON_RELOAD_START = 1u << 10,
+    ITEM_HOOK_ON_RELOAD_FINISH = 1u << 11,
+};
+enum GunHook : std::uint32_t {
+    GUN_HOOK_ON_JAM = 1u << 0,
+    GUN_HOOK_ON_ACTIVE_RELOAD = 1u << 1,
+    GUN_HOOK_ON_FAILED_ACTIVE_RELOAD = 1u << 2,
+    GUN_HOOK_ON_TRIED_AFTER_FAILED_AR = 1u << 3,
+    GUN_HOOK_ON_PICKUP = 1u << 4,
+    GUN_HOOK_ON_DROP = 1u << 5,
+    GUN_HOOK_ON_STEP = 1u << 6,
+    GUN_HOOK_ON_EJECT = 1u << 7,
+    GUN_HOOK_ON_RELOAD_START = 1u << 8,
+    GUN_HOOK_ON_RELOAD_FINISH = 1u << 9,
+};
+enum AmmoHook : std::uint32_t {
+    AMMO_HOOK_ON_HIT = 1u << 0,
+    AMMO_HOOK_ON_HIT_ENTITY = 1u << 1,
+    AMMO_HOOK_ON_HIT_TILE = 1u << 2,
+};
+enum ProjectileHook : std::uint32_t {
+    PROJECTILE_HOOK_ON_HIT_ENTITY = 1u << 0,
+    PROJECTILE_HOOK_ON_HIT_TILE = 1u << 1,
+};
+enum CrateHook : std::uint32_t {
+    CRATE_HOOK_ON_OPEN = 1u << 0,
+};
+enum EntityHook : std::uint32_t {
+    ENTITY_HOOK_ON_STEP = 1u << 0,
+    ENTITY_HOOK_ON_DAMAGE = 1u << 1,
+    ENTITY_HOOK_ON_SPAWN = 1u << 2,
+    ENTITY_HOOK_ON_DEATH = 1u << 3,
+    ENTITY_HOOK_ON_RELOAD_START = 1u << 4,
+    ENTITY_HOOK_ON_RELOAD_FINISH = 1u << 5,
+    ENTITY_HOOK_ON_GUN_JAM = 1u << 6,
+    ENTITY_HOOK_ON_OUT_OF_AMMO = 1u << 7,
+    ENTITY_HOOK_ON_HP_UNDER_50 = 1u << 8,
+    ENTITY_HOOK_ON_HP_UNDER_25 = 1u << 9,
+    ENTITY_HOOK_ON_HP_FULL = 1u << 10,
+    ENTITY_HOOK_ON_SHIELD_UNDER_50 = 1u << 11,
+    ENTITY_HOOK_ON_SHIELD_UNDER_25 = 1u << 12,
+    ENTITY_HOOK_ON_SHIELD_FULL = 1u << 13,
+    ENTITY_HOOK_ON_PLATES_LOST = 1u << 14,
+    ENTITY_HOOK_ON_COLLIDE_TILE = 1u << 15,
+    ENTITY_HOOK_ON_STEP_BATCH = 1u << 16,
+};
 
 struct PowerupDef {
     std::string name;
     int type = 0;
     std::string sprite;
+    int sprite_id{-1};
 };
 
 struct ItemDef {
@@ -22,9 +94,13 @@ struct ItemDef {
     std::string desc;
     std::string sound_use;
     std::string sound_pickup;
+    int sprite_id{-1};
+    int sound_use_id{-1};
+    int sound_pickup_id{-1}; // falls back to base:drop
+    std::uint32_t hooks{0};  // ItemHook bits
     // Optional ticking (opt-in)
     float tick_rate_hz{0.0f};
-    std::string tick_phase; // "before" or "after" (default after)
+    TickPhase tick_phase{TICK_AFTER_PHYSICS}; // Lua: "before" or "after" (default)
     // callbacks stored internally; not exposed here
 };
 
@@ -47,6 +123,12 @@ struct GunDef {
     std::string sound_reload;
     std::string sound_jam;
     std::string sound_pickup;
+    int sprite_id{-1};
+    int sound_fire_id{-1};   // falls back to base:small_shoot
+    int sound_reload_id{-1}; // falls back to base:reload
+    int sound_jam_id{-1};    // falls back to base:ui_cant
+    int sound_pickup_id{-1}; // falls back to base:drop
+    std::uint32_t hooks{0};  // GunHook bits
     float jam_chance{0.0f}; // per-gun additive jam chance
     int projectile_type{0}; // projectile def to use
     std::string fire_mode;  // "auto", "single", or "burst"
@@ -65,7 +147,7 @@ struct GunDef {
     float active_reload_window{0.0f}; // legacy fallback for ar_size when >0
     // Optional ticking (opt-in)
     float tick_rate_hz{0.0f};
-    std::string tick_phase; // "before" or "after" (default after)
+    TickPhase tick_phase{TICK_AFTER_PHYSICS}; // Lua: "before" or "after" (default)
     // Ammo compatibility (weighted pick on spawn)
     std::vector<AmmoCompat> compatible_ammo; // {type, weight}
 };
@@ -75,8 +157,12 @@ struct ProjectileDef {
     int type = 0;
     float speed = 20.0f;
     float size_x = 0.2f, size_y = 0.2f;
-    int physics_steps = 2;
+    // Legacy substep count. Projectile collision is swept exactly, so this is
+    // accepted for old mods but has no effect.
+    std::optional<int> physics_steps;
     std::string sprite; // namespaced sprite key (e.g., "mod:bullet")
+    int sprite_id{-1};
+    std::uint32_t hooks{0}; // ProjectileHook bits
     // callbacks stored internally; not exposed here
 };
 
@@ -87,6 +173,7 @@ struct AmmoDef {
     std::string desc;
     // Visuals / kinematics
     std::string sprite;   // namespaced sprite key for projectile
+    int sprite_id{-1};
     float size_x{0.2f}, size_y{0.2f};
     float speed{20.0f};   // projectile speed (world units/sec)
     // Damage model
@@ -99,17 +186,10 @@ struct AmmoDef {
     float falloff_end{0.0f};        // distance where falloff reaches min
     float falloff_min_mult{1.0f};   // min damage multiplier at/after falloff_end
     int pierce_count{0};            // number of entities to pierce through
+    std::uint32_t hooks{0};         // AmmoHook bits
     // Optional hooks stored internally; not exposed here
 };
 
-inline const GunDef* find_gun_def_by_type(const std::vector<GunDef>& defs, int type) {
-    for (auto const& g : defs) {
-        if (g.type == type)
-            return &g;
-    }
-    return nullptr;
-}
-
 struct DropEntry {
     int type{0};
     float weight{1.0f};
@@ -126,6 +206,7 @@ struct CrateDef {
     float open_time = 5.0f;
     std::string label;
     DropTables drops;
+    std::uint32_t hooks{0}; // CrateHook bits
     // on_open stored internally; not exposed here
 };
 
@@ -134,6 +215,8 @@ struct EntityTypeDef {
     std::string name;
     int type = 0;
     std::string sprite;   // namespaced sprite key
+    int sprite_id{-1};
+    std::uint32_t hooks{0}; // EntityHook bits
     // Sizes in world units
     float sprite_w{0.25f};
     float sprite_h{0.25f};
@@ -169,6 +252,6 @@ struct EntityTypeDef {
     float terror_level{100.0f};
     // Optional ticking
     float tick_rate_hz{0.0f};
-    std::string tick_phase; // "before" or "after" (default after)
+    TickPhase tick_phase{TICK_AFTER_PHYSICS}; // Lua: "before" or "after" (default)
     // All callbacks stored internally; not exposed here
 };
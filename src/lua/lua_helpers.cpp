@@ -3,6 +3,7 @@
 LuaManager* g_mgr = nullptr;
 State* g_state_ctx = nullptr;
 Entity* g_player_ctx = nullptr;
+LuaInstanceCtx g_instance_ctx{};
 
 LuaCtxGuard::LuaCtxGuard(State* s, Entity* p) {
     g_state_ctx = s;
@@ -14,3 +15,10 @@ LuaCtxGuard::~LuaCtxGuard() {
     g_player_ctx = nullptr;
 }
 
+LuaInstanceGuard::LuaInstanceGuard(int kind, VID vid) : prev(g_instance_ctx) {
+    g_instance_ctx = LuaInstanceCtx{kind, vid};
+}
+
+LuaInstanceGuard::~LuaInstanceGuard() {
+    g_instance_ctx = prev;
+}
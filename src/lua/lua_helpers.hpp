@@ -1,5 +1,9 @@
 #pragma once
 
+#include "types.hpp"
+
+#include <cstdint>
+
 struct State;
 struct Entity;
 class LuaManager;
@@ -14,3 +18,27 @@ struct LuaCtxGuard {
     ~LuaCtxGuard();
 };
 
+// Gun/item instance whose hook is running (kind is INV_GUN or INV_ITEM;
+// 0 => none). Set by the tick phases, where the instance is known.
+struct LuaInstanceCtx {
+    int kind{0};
+    VID vid{};
+};
+extern LuaInstanceCtx g_instance_ctx;
+
+// Sets g_instance_ctx for its scope; restores the previous one.
+struct LuaInstanceGuard {
+    LuaInstanceGuard(int kind, VID vid);
+    ~LuaInstanceGuard();
+    LuaInstanceCtx prev;
+};
+
+
+// Lua-side entity handle: slot id in the low 32 bits, version above. Stale
+// handles fail the version check on lookup; forged ids fail its range check.
+inline std::int64_t entity_handle(VID v) {
+    return (static_cast<std::int64_t>(v.version) << 32) | static_cast<std::int64_t>(v.id);
+}
+inline VID entity_vid(std::int64_t h) {
+    return VID{static_cast<std::size_t>(h & 0xffffffff), static_cast<std::uint32_t>(h >> 32)};
+}
@@ -26,6 +26,7 @@ void lua_register_ammo(sol::state& s, LuaManager& m) {
         if (auto o = t.get<sol::object>("on_hit_entity"); o.is<sol::function>()) ah.on_hit_entity = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_hit_tile"); o.is<sol::function>()) ah.on_hit_tile = o.as<sol::protected_function>();
         m.add_ammo(d);
+        ah.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->ammo[d.type] = ah;
     });
 }
@@ -36,6 +36,7 @@ void lua_register_crates(sol::state& s, LuaManager& m) {
             parse_list("guns", d.drops.guns);
         }
         m.add_crate(d);
+        ch.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->crates[d.type] = ch;
     });
 }
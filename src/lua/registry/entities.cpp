@@ -41,7 +41,7 @@ void lua_register_entities(sol::state& s, LuaManager& m) {
         d.move_spread_decay_deg_per_sec = t.get_or("move_spread_decay_deg_per_sec", 10.0f);
         d.move_spread_max_deg = t.get_or("move_spread_max_deg", 20.0f);
         d.tick_rate_hz = t.get_or("tick_rate_hz", 0.0f);
-        d.tick_phase = t.get_or("tick_phase", std::string("after"));
+        d.tick_phase = tick_phase_from(t.get_or("tick_phase", std::string("after")));
         EntityHooks eh{};
         if (auto o = t.get<sol::object>("on_step"); o.is<sol::function>()) eh.on_step = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_damage"); o.is<sol::function>()) eh.on_damage = o.as<sol::protected_function>();
@@ -59,7 +59,9 @@ void lua_register_entities(sol::state& s, LuaManager& m) {
         if (auto o = t.get<sol::object>("on_shield_full"); o.is<sol::function>()) eh.on_shield_full = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_plates_lost"); o.is<sol::function>()) eh.on_plates_lost = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_collide_tile"); o.is<sol::function>()) eh.on_collide_tile = o.as<sol::protected_function>();
+        if (auto o = t.get<sol::object>("on_step_batch"); o.is<sol::function>()) eh.on_step_batch = o.as<sol::protected_function>();
         m.add_entity_type(d);
+        eh.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->entities[d.type] = eh;
     });
 }
@@ -24,7 +24,7 @@ void lua_register_guns(sol::state& s, LuaManager& m) {
         d.sound_jam = t.get_or("sound_jam", std::string{});
         d.sound_pickup = t.get_or("sound_pickup", std::string{});
         d.tick_rate_hz = t.get_or("tick_rate_hz", 0.0f);
-        d.tick_phase = t.get_or("tick_phase", std::string("after"));
+        d.tick_phase = tick_phase_from(t.get_or("tick_phase", std::string("after")));
         d.fire_mode = t.get_or("fire_mode", std::string("auto"));
         d.burst_count = t.get_or("burst_count", 0);
         d.burst_rpm = t.get_or("burst_rpm", 0.0f);
@@ -69,6 +69,7 @@ void lua_register_guns(sol::state& s, LuaManager& m) {
             }
         }
         m.add_gun(d);
+        gh.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->guns[d.type] = gh;
     });
 }
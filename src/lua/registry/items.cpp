@@ -27,13 +27,14 @@ void lua_register_items(sol::state& s, LuaManager& m) {
         ItemHooks ih{};
         if (auto o = t.get<sol::object>("on_use"); o.is<sol::function>()) ih.on_use = o.as<sol::protected_function>();
         d.tick_rate_hz = t.get_or("tick_rate_hz", 0.0f);
-        d.tick_phase = t.get_or("tick_phase", std::string("after"));
+        d.tick_phase = tick_phase_from(t.get_or("tick_phase", std::string("after")));
         if (auto o = t.get<sol::object>("on_active_reload"); o.is<sol::function>()) ih.on_active_reload = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_failed_active_reload"); o.is<sol::function>()) ih.on_failed_active_reload = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_tried_to_active_reload_after_failing"); o.is<sol::function>()) ih.on_tried_after_failed_ar = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_pickup"); o.is<sol::function>()) ih.on_pickup = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_drop"); o.is<sol::function>()) ih.on_drop = o.as<sol::protected_function>();
         m.add_item(d);
+        ih.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->items[d.type] = ih;
     });
 }
@@ -10,12 +10,13 @@ void lua_register_projectiles(sol::state& s, LuaManager& m) {
         d.speed = t.get_or("speed", 20.0f);
         d.size_x = t.get_or("size_x", 0.2f);
         d.size_y = t.get_or("size_y", 0.2f);
-        d.physics_steps = t.get_or("physics_steps", 2);
+        if (auto o = t.get<sol::object>("physics_steps"); o.is<int>()) d.physics_steps = o.as<int>();
         d.sprite = t.get_or("sprite", std::string{});
         ProjectileHooks ph{};
         if (auto o = t.get<sol::object>("on_hit_entity"); o.is<sol::function>()) ph.on_hit_entity = o.as<sol::protected_function>();
         if (auto o = t.get<sol::object>("on_hit_tile"); o.is<sol::function>()) ph.on_hit_tile = o.as<sol::protected_function>();
         m.add_projectile(d);
+        ph.stats.mod = lua_mem_owner();
         if (d.type != 0 && m.hooks_) m.hooks_->projectiles[d.type] = ph;
     });
 }
@@ -14,6 +14,7 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 
@@ -24,6 +25,7 @@ LuaManager::LuaManager() {}
 LuaManager::~LuaManager() {
     // Destroy hooks (which hold sol::protected_function) BEFORE destroying the Lua state.
     if (hooks_) { delete hooks_; hooks_ = nullptr; }
+    if (timers_) { delete timers_; timers_ = nullptr; }
     if (S) { delete S; S = nullptr; L = nullptr; }
 }
 
@@ -37,16 +39,21 @@ void LuaManager::clear() {
     ammo_.clear();
     crates_.clear();
     entity_types_.clear();
+    // Timers hold functions from the previous load
+    if (timers_) *timers_ = LuaTimers{};
 }
 
 bool LuaManager::init() {
     if (S)
         return true;
-    S = new sol::state();
+    S = new sol::state(sol::default_at_panic, lua_mem_alloc, &mem_);
     S->open_libraries(sol::lib::base, sol::lib::math, sol::lib::package, sol::lib::string,
                       sol::lib::table, sol::lib::os);
     L = S->lua_state();
+    lua_watch_install(L);
+    lua_gc(L, LUA_GCSTOP); // stepped from the main loop; see gc_step
     if (!hooks_) hooks_ = new LuaHooks();
+    if (!timers_) timers_ = new LuaTimers();
     return register_api();
 }
 
@@ -66,22 +73,30 @@ bool LuaManager::register_api() {
     // Named table 'api' functions
     lua_register_api_player(s, *this);
     lua_register_api_world(s, *this);
-
-    // Optional registered global handlers
-    s.set_function("register_on_dash", [this](sol::function f) { hooks_->global.on_dash = sol::protected_function(f); });
-    s.set_function("register_on_active_reload", [this](sol::function f) { hooks_->global.on_active_reload = sol::protected_function(f); });
-    s.set_function("register_on_step", [this](sol::function f) { hooks_->global.on_step = sol::protected_function(f); });
-    s.set_function("register_on_failed_active_reload", [this](sol::function f) { hooks_->global.on_failed_active_reload = sol::protected_function(f); });
-    s.set_function("register_on_tried_to_active_reload_after_failing", [this](sol::function f) { hooks_->global.on_tried_after_failed_ar = sol::protected_function(f); });
-    s.set_function("register_on_eject", [this](sol::function f) { hooks_->global.on_eject = sol::protected_function(f); });
-    s.set_function("register_on_reload_start", [this](sol::function f) { hooks_->global.on_reload_start = sol::protected_function(f); });
-    s.set_function("register_on_reload_finish", [this](sol::function f) { hooks_->global.on_reload_finish = sol::protected_function(f); });
+    lua_register_api_timers(s, *this);
+
+    // Optional registered global handlers (their calls are charged to the
+    // mod that registered last)
+    s.set_function("register_on_dash", [this](sol::function f) { hooks_->global.on_dash = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_active_reload", [this](sol::function f) { hooks_->global.on_active_reload = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_step", [this](sol::function f) { hooks_->global.on_step = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_failed_active_reload", [this](sol::function f) { hooks_->global.on_failed_active_reload = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_tried_to_active_reload_after_failing", [this](sol::function f) { hooks_->global.on_tried_after_failed_ar = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_eject", [this](sol::function f) { hooks_->global.on_eject = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_reload_start", [this](sol::function f) { hooks_->global.on_reload_start = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
+    s.set_function("register_on_reload_finish", [this](sol::function f) { hooks_->global.on_reload_finish = sol::protected_function(f); hooks_->global.stats.mod = lua_mem_owner(); });
 
     return true;
 }
 
 bool LuaManager::run_file(const std::string& path) {
-    sol::protected_function_result r = S->safe_script_file(path);
+    if (bytecode_cache_.load(L, path) != LUA_OK) {
+        std::fprintf(stderr, "[lua] error in %s: %s\n", path.c_str(), lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+    auto chunk = sol::stack::pop<sol::protected_function>(L);
+    sol::protected_function_result r = chunk();
     if (!r.valid()) {
         sol::error e = r;
         std::fprintf(stderr, "[lua] error in %s: %s\n", path.c_str(), e.what());
@@ -101,6 +116,9 @@ void LuaManager::call_generate_room() {
 bool LuaManager::load_mods() {
     auto mods_root = mm->root;
     clear();
+    const auto t0 = std::chrono::steady_clock::now();
+    bytecode_cache_.hits = 0;
+    bytecode_cache_.misses = 0;
     std::error_code ec;
     if (!fs::exists(mods_root, ec) || !fs::is_directory(mods_root, ec))
         return false;
@@ -109,6 +127,7 @@ bool LuaManager::load_mods() {
         if (!mod.is_directory()) continue;
         fs::path sdir = mod.path() / "scripts";
         if (fs::exists(sdir, ec) && fs::is_directory(sdir, ec)) {
+            LuaMemScope _mem(mem_.mod_id(mod.path().filename().string()));
             // Clear per-mod api_version global before loading this mod's scripts
             S->set("api_version", sol::lua_nil);
             for (auto const& f : fs::directory_iterator(sdir, ec)) {
@@ -136,6 +155,11 @@ bool LuaManager::load_mods() {
             S->set("api_version", sol::lua_nil);
         }
     }
+    // Cold (all compiled) vs warm (all cached) loads compare on this line
+    std::printf("[lua] scripts: %zu in %.1f ms (%zu from bytecode cache, %zu compiled%s)\n",
+                bytecode_cache_.hits + bytecode_cache_.misses,
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count(),
+                bytecode_cache_.hits, bytecode_cache_.misses, bytecode_cache_.enabled ? "" : "; cache off");
     std::printf("[lua] loaded: %zu powerups, %zu items, %zu guns, %zu ammo, %zu projectiles, %zu entity types\n",
                 powerups_.size(), items_.size(), guns_.size(), ammo_.size(), projectiles_.size(), entity_types_.size());
     // Optional drop tables
@@ -167,5 +191,29 @@ bool LuaManager::load_mods() {
         }
     }
     // Note: per-mod api_version check performed during load above.
+    link();
+    compile_hooks();
+    // Drop what the previous load left behind while we are between frames anyway
+    lua_gc(L, LUA_GCCOLLECT);
+    mem_.gc_active = false;
+    mem_.gc_floor = mem_.total;
+    std::printf("[lua] memory: %.1f KB live, %.1f KB reserved\n", static_cast<double>(mem_.total) / 1024.0,
+                static_cast<double>(mem_.reserved) / 1024.0);
     return true;
 }
+
+void LuaManager::gc_step(double seconds) {
+    if (L) lua_gc_step(L, mem_, seconds);
+}
+
+void LuaManager::log_memory_stats() const {
+    std::printf("[lua] memory: %.1f KB live, %.1f KB reserved, %llu gc cycles\n",
+                static_cast<double>(mem_.total) / 1024.0, static_cast<double>(mem_.reserved) / 1024.0,
+                static_cast<unsigned long long>(mem_.gc_cycles));
+    for (const LuaModMem& m : mem_.mods) {
+        if (m.allocs == 0) continue;
+        std::printf("[lua]   %-24s %10.1f KB live %10.1f KB peak %12llu allocs\n", m.name.c_str(),
+                    static_cast<double>(m.bytes) / 1024.0, static_cast<double>(m.peak) / 1024.0,
+                    static_cast<unsigned long long>(m.allocs));
+    }
+}
@@ -0,0 +1,98 @@
+#include "lua/watchdog.hpp"
+// watchdog: instruction budgets for hook calls and tick phases
+
+#include <lua.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+constexpr double ABORT_LOG_INTERVAL = 5.0; // seconds, per def
+
+struct Watch {
+    HookStats* stats{nullptr};
+    std::uint64_t used{0}; // current call, nested calls included
+    bool aborted{false};   // current call hit a budget
+    int depth{0};
+    bool in_phase{false};
+    std::uint64_t phase_used{0};
+};
+
+Watch g_watch;
+
+void count_hook(lua_State* L, lua_Debug*) {
+    Watch& w = g_watch;
+    if (w.depth == 0) return; // script loading and other unguarded calls run free
+    w.used += LUA_WATCH_STEP;
+    if (w.stats) w.stats->instructions += LUA_WATCH_STEP;
+    if (w.in_phase) w.phase_used += LUA_WATCH_STEP;
+    if (w.used > LUA_CALL_BUDGET || (w.in_phase && w.phase_used > LUA_PHASE_BUDGET)) {
+        if (!w.aborted && w.stats) w.stats->aborts += 1;
+        w.aborted = true;
+        luaL_error(L, "instruction budget exceeded");
+    }
+}
+
+double now_seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void lua_watch_install(lua_State* L) {
+    // Threads made later (timer coroutines) inherit the hook
+    lua_sethook(L, count_hook, LUA_MASKCOUNT, LUA_WATCH_STEP);
+}
+
+LuaWatch::LuaWatch(HookStats& s)
+    : stats_(&s), prev_stats(g_watch.stats), prev_used(g_watch.used), prev_aborted(g_watch.aborted), mem(s.mod) {
+    g_watch.stats = &s;
+    g_watch.used = 0;
+    g_watch.aborted = false;
+    g_watch.depth += 1;
+    s.calls += 1;
+}
+
+LuaWatch::~LuaWatch() {
+    std::uint64_t used = g_watch.used;
+    g_watch.depth -= 1;
+    g_watch.stats = prev_stats;
+    g_watch.used = prev_used + used;
+    g_watch.aborted = prev_aborted;
+}
+
+bool LuaWatch::aborted() const {
+    return g_watch.aborted;
+}
+
+void lua_watch_phase_begin() {
+    g_watch.in_phase = true;
+    g_watch.phase_used = 0;
+}
+
+void lua_watch_phase_end() {
+    g_watch.in_phase = false;
+}
+
+bool lua_watch_phase_spent() {
+    return g_watch.in_phase && g_watch.phase_used > LUA_PHASE_BUDGET;
+}
+
+void lua_hook_error(HookStats& s, bool aborted, const char* what, const char* msg) {
+    if (!aborted) {
+        std::fprintf(stderr, "[lua] %s error: %s\n", what, msg);
+        return;
+    }
+    double now = now_seconds();
+    if (now - s.last_log < ABORT_LOG_INTERVAL) {
+        s.unlogged += 1;
+        return;
+    }
+    std::fprintf(stderr,
+                 "[lua] %s (type %d) aborted: over instruction budget (%llu calls, %llu aborts, %u not logged)\n",
+                 what, s.type, static_cast<unsigned long long>(s.calls), static_cast<unsigned long long>(s.aborts),
+                 s.unlogged);
+    s.last_log = now;
+    s.unlogged = 0;
+}
@@ -0,0 +1,62 @@
+// Lua watchdog.
+// Responsibility: bound how many VM instructions one hook call and one tick
+// phase may run (a lua_sethook count hook), abort overruns with a Lua error,
+// and keep per-def call/instruction/abort counters.
+#pragma once
+
+#include <cstdint>
+#include "lua/allocator.hpp"
+
+struct lua_State;
+
+// Instructions are sampled every LUA_WATCH_STEP, so counts are in those units.
+inline constexpr int LUA_WATCH_STEP = 1000;
+inline constexpr std::uint64_t LUA_CALL_BUDGET = 5'000'000;   // per hook call, nested calls included
+inline constexpr std::uint64_t LUA_PHASE_BUDGET = 20'000'000; // per tick phase, all hooks and timers
+
+struct HookStats {
+    int type{0};          // def type; 0 for global hooks and timers
+    std::uint16_t mod{0}; // LuaMemory owner charged while it runs
+    std::uint64_t calls{0};
+    std::uint64_t instructions{0};
+    std::uint64_t aborts{0};
+    // Abort log rate limit
+    double last_log{-1e9};
+    std::uint32_t unlogged{0};
+};
+
+void lua_watch_install(lua_State* L);
+
+// Scope of one guarded hook call; counts go to `s`, allocations to s.mod.
+struct LuaWatch {
+    explicit LuaWatch(HookStats& s);
+    ~LuaWatch();
+    LuaWatch(const LuaWatch&) = delete;
+    LuaWatch& operator=(const LuaWatch&) = delete;
+
+    HookStats& stats() const { return *stats_; }
+    // This call hit a budget. Nested guards restore the flag on exit, so it
+    // is only meaningful while this guard is the innermost one.
+    bool aborted() const;
+
+  private:
+    HookStats* stats_;
+    HookStats* prev_stats;
+    std::uint64_t prev_used;
+    bool prev_aborted;
+    LuaMemScope mem;
+};
+
+// Tick phases: everything between begin and end shares LUA_PHASE_BUDGET.
+void lua_watch_phase_begin();
+void lua_watch_phase_end();
+bool lua_watch_phase_spent();
+
+// Report a failed hook call. Budget aborts are rate limited per def; other
+// errors print as they always have.
+void lua_hook_error(HookStats& s, bool aborted, const char* what, const char* msg);
+
+// Report from inside the guard that ran the call, while its result is live.
+inline void lua_hook_error(const LuaWatch& w, const char* what, const char* msg) {
+    lua_hook_error(w.stats(), w.aborted(), what, msg);
+}
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
+#include "lua/allocator.hpp"
+#include "lua/bytecode_cache.hpp"
+#include "lua/def_table.hpp"
 #include "lua/lua_defs.hpp"
 
 struct State;
 struct Entity;
+struct VID;
 namespace sol { struct state; }
 struct lua_State; // forward-declare C Lua state; provided by sol2 at runtime
 
@@ -16,6 +21,31 @@ struct LuaManager {
     bool available() const;
     bool init();
     bool load_mods();
+    // Load scripts from cached bytecode when it is still valid (default on).
+    void set_bytecode_cache(bool on) {
+        bytecode_cache_.enabled = on;
+    }
+    // Resolve def sprite/sound keys into the *_id handles on the defs and log
+    // each dangling reference once. Runs at the end of load_mods; call again
+    // after sprites are rebuilt. Returns the number of unresolved references.
+    std::size_t link();
+    std::size_t unresolved_refs() const {
+        return unresolved_refs_;
+    }
+    // Resume due api.after/api.every timers for one tick phase; called once
+    // per fixed step from the tick phases.
+    void run_timers(TickPhase phase);
+    // Print the `top` hooks by budget aborts, then instructions (calls,
+    // sampled instructions, aborts per def); see lua/watchdog.hpp.
+    void log_hook_stats(std::size_t top) const;
+    // Lua heap per mod (live, peak) and in total; see lua/allocator.hpp.
+    const LuaMemory& memory() const {
+        return mem_;
+    }
+    void log_memory_stats() const;
+    // Incremental GC with up to `seconds` of spare frame time. The collector
+    // never runs on its own, so it stays out of the fixed-step ticks.
+    void gc_step(double seconds);
     // Allow registration helpers to access internals without exposing sol types
     friend void lua_register_powerups(sol::state& s, LuaManager& m);
     friend void lua_register_items(sol::state& s, LuaManager& m);
@@ -24,6 +54,7 @@ struct LuaManager {
     friend void lua_register_projectiles(sol::state& s, LuaManager& m);
     friend void lua_register_crates(sol::state& s, LuaManager& m);
     friend void lua_register_entities(sol::state& s, LuaManager& m);
+    friend void lua_register_api_timers(sol::state& s, LuaManager& m);
     // Trigger calls
     bool call_item_on_use(int item_type, struct Entity& player, std::string* out_msg);
     void call_item_on_tick(int item_type, struct Entity& player, float dt);
@@ -31,16 +62,10 @@ struct LuaManager {
     void call_item_on_damage(int item_type, struct Entity& player, int attacker_ap);
     void call_gun_on_jam(int gun_type, struct Entity& player);
     const ProjectileDef* find_projectile(int type) const {
-        for (auto const& p : projectiles_)
-            if (p.type == type)
-                return &p;
-        return nullptr;
+        return projectiles_.find(type);
     }
     const GunDef* find_gun(int type) const {
-        for (auto const& g : guns_)
-            if (g.type == type)
-                return &g;
-        return nullptr;
+        return guns_.find(type);
     }
     void call_projectile_on_hit_entity(int proj_type);
     void call_projectile_on_hit_tile(int proj_type);
@@ -75,13 +100,12 @@ struct LuaManager {
     void call_gun_on_reload_finish(int gun_type, struct Entity& player);
     void call_item_on_reload_finish(int item_type, struct Entity& player);
     const CrateDef* find_crate(int type) const {
-        for (auto const& c : crates_)
-            if (c.type == type)
-                return &c;
-        return nullptr;
+        return crates_.find(type);
     }
     void call_generate_room();
     void call_entity_on_step(int entity_type, struct Entity& e);
+    // on_step_batch(handles): one call for n entities of a type; see api.use_entity.
+    void call_entity_on_step_batch(int entity_type, const VID* vids, std::size_t n);
     void call_entity_on_damage(int entity_type, struct Entity& e, int attacker_ap);
     void call_entity_on_spawn(int entity_type, struct Entity& e);
     void call_entity_on_death(int entity_type, struct Entity& e);
@@ -102,75 +126,83 @@ struct LuaManager {
     bool has_gun_on_step(int gun_type) const;
     bool has_item_on_tick(int item_type) const;
     bool has_entity_on_step(int entity_type) const;
+    bool has_entity_on_step_batch(int entity_type) const;
 
     const std::vector<PowerupDef>& powerups() const {
-        return powerups_;
+        return powerups_.all();
     }
     const std::vector<ItemDef>& items() const {
-        return items_;
+        return items_.all();
+    }
+    const PowerupDef* find_powerup(int type) const {
+        return powerups_.find(type);
+    }
+    const ItemDef* find_item(int type) const {
+        return items_.find(type);
     }
     const std::vector<GunDef>& guns() const {
-        return guns_;
+        return guns_.all();
     }
     const std::vector<ProjectileDef>& projectiles() const {
-        return projectiles_;
+        return projectiles_.all();
     }
     const DropTables& drops() const {
         return drops_;
     }
-    const std::vector<AmmoDef>& ammo() const { return ammo_; }
+    const std::vector<AmmoDef>& ammo() const { return ammo_.all(); }
     const AmmoDef* find_ammo(int type) const {
-        for (auto const& a : ammo_)
-            if (a.type == type)
-                return &a;
-        return nullptr;
+        return ammo_.find(type);
     }
     const std::vector<CrateDef>& crates() const {
-        return crates_;
+        return crates_.all();
     }
-    const std::vector<EntityTypeDef>& entity_types() const { return entity_types_; }
+    const std::vector<EntityTypeDef>& entity_types() const { return entity_types_.all(); }
     const EntityTypeDef* find_entity_type(int type) const {
-        for (auto const& e : entity_types_) {
-            if (e.type == type)
-                return &e;
-        }
-        return nullptr;
+        return entity_types_.find(type);
     }
 
     // Registration (used by Lua bindings)
     void add_powerup(const PowerupDef& d) {
-        powerups_.push_back(d);
+        powerups_.add(d);
     }
     void add_item(const ItemDef& d) {
-        items_.push_back(d);
+        items_.add(d);
     }
     void add_gun(const GunDef& d) {
-        guns_.push_back(d);
+        guns_.add(d);
     }
     void add_projectile(const ProjectileDef& d) {
-        projectiles_.push_back(d);
+        projectiles_.add(d);
     }
-    void add_ammo(const AmmoDef& d) { ammo_.push_back(d); }
+    void add_ammo(const AmmoDef& d) { ammo_.add(d); }
     void add_crate(const CrateDef& d) {
-        crates_.push_back(d);
+        crates_.add(d);
     }
-    void add_entity_type(const EntityTypeDef& d) { entity_types_.push_back(d); }
+    void add_entity_type(const EntityTypeDef& d) { entity_types_.add(d); }
 
   private:
     void clear();
+    // Move staged per-type hooks into dense tables indexed like the defs and
+    // set each def's `hooks` mask. Runs at the end of load_mods.
+    void compile_hooks();
     bool register_api();
     bool run_file(const std::string& path);
 
-    std::vector<PowerupDef> powerups_;
-    std::vector<ItemDef> items_;
-    std::vector<GunDef> guns_;
-    std::vector<ProjectileDef> projectiles_;
-    std::vector<AmmoDef> ammo_;
-    std::vector<CrateDef> crates_;
-    std::vector<EntityTypeDef> entity_types_;
+    DefTable<PowerupDef> powerups_;
+    DefTable<ItemDef> items_;
+    DefTable<GunDef> guns_;
+    DefTable<ProjectileDef> projectiles_;
+    DefTable<AmmoDef> ammo_;
+    DefTable<CrateDef> crates_;
+    DefTable<EntityTypeDef> entity_types_;
     DropTables drops_;
 
+    std::size_t unresolved_refs_{0};
+    BytecodeCache bytecode_cache_;
+    LuaMemory mem_; // outlives S (deleted first in the destructor)
+
     lua_State* L{nullptr};
     sol::state* S{nullptr};
     struct LuaHooks* hooks_{nullptr};
+    struct LuaTimers* timers_{nullptr};
 };
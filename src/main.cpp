@@ -5,6 +5,7 @@
 #include "luamgr.hpp"
 #include "mods.hpp"
 #include "projectiles.hpp"
+#include "projectiles_bench.hpp"
 #include "settings.hpp"
 #include "audio.hpp"
 #include "sprites.hpp"
@@ -30,11 +31,18 @@
 int main(int argc, char** argv) {
     // Lightweight CLI args for non-interactive testing
     bool arg_headless = false;
+    bool arg_no_lua_cache = false; // always compile mod scripts from source
     long arg_frames = -1; // <0 => unlimited
+    long arg_max_projectiles = -1; // <0 => MAX_PROJECTILES
+    long arg_projectile_threads = -1; // <0 => 1 (main thread only); 0 => all cores
+    long arg_bench_projectiles = -1; // >=0 => run the projectile benchmark up to N threads and exit
+    long arg_vram_budget_mb = -1; // <=0 => TextureAtlas default
     for (int i = 1; i < argc; ++i) {
         std::string a(argv[i]);
         if (a == "--headless")
             arg_headless = true;
+        else if (a == "--no-lua-cache")
+            arg_no_lua_cache = true;
         else if (a.rfind("--frames=", 0) == 0) {
             std::string v = a.substr(9);
             try {
@@ -42,9 +50,40 @@ int main(int argc, char** argv) {
             } catch (...) {
                 arg_frames = -1;
             }
+        } else if (a.rfind("--max-projectiles=", 0) == 0) {
+            std::string v = a.substr(18);
+            try {
+                arg_max_projectiles = std::stol(v);
+            } catch (...) {
+                arg_max_projectiles = -1;
+            }
+        } else if (a.rfind("--projectile-threads=", 0) == 0) {
+            std::string v = a.substr(21);
+            try {
+                arg_projectile_threads = std::stol(v);
+            } catch (...) {
+                arg_projectile_threads = -1;
+            }
+        } else if (a.rfind("--bench-projectiles=", 0) == 0) {
+            std::string v = a.substr(20);
+            try {
+                arg_bench_projectiles = std::stol(v);
+            } catch (...) {
+                arg_bench_projectiles = -1;
+            }
+        } else if (a.rfind("--vram-budget-mb=", 0) == 0) {
+            std::string v = a.substr(17);
+            try {
+                arg_vram_budget_mb = std::stol(v);
+            } catch (...) {
+                arg_vram_budget_mb = -1;
+            }
         }
     }
 
+    if (arg_bench_projectiles >= 0)
+        return run_projectile_bench(static_cast<int>(arg_bench_projectiles));
+
     if (
         !init_graphics(arg_headless)
     ) {
@@ -56,6 +95,10 @@ int main(int argc, char** argv) {
         SDL_Quit();
         return 1;
     }
+    if (arg_max_projectiles > 0)
+        ss->projectiles.set_capacity(static_cast<std::size_t>(arg_max_projectiles));
+    if (arg_projectile_threads >= 0)
+        ss->workers.set_threads(static_cast<std::size_t>(arg_projectile_threads));
 
     // Audio (SDL_mixer)
     if (!init_audio()) {
@@ -70,6 +113,8 @@ int main(int argc, char** argv) {
     discover_mods();
     scan_mods_for_sprite_defs();
     if (!arg_headless) {
+        if (arg_vram_budget_mb > 0)
+            gg->atlas.budget = static_cast<std::size_t>(arg_vram_budget_mb) << 20;
         load_all_textures_in_sprite_lookup();
         load_mod_sounds();
     }
@@ -80,6 +125,7 @@ int main(int argc, char** argv) {
         std::fprintf(stderr, "Lua 5.4 not available. Install lua5.4. Exiting.\n");
         return 1;
     }
+    luam->set_bytecode_cache(!arg_no_lua_cache);
     luam->load_mods();
 
     if (!load_input_bindings_from_ini("config/input.ini")) {
@@ -112,6 +158,12 @@ int main(int argc, char** argv) {
             if (ev.type == SDL_WINDOWEVENT && ev.window.event == SDL_WINDOWEVENT_CLOSE)
                 ss->running = false;
             process_event(ev);
+            // Cached render targets lose their contents (or the textures
+            // themselves, on device reset)
+            if (ev.type == SDL_RENDER_TARGETS_RESET)
+                invalidate_tile_layer();
+            else if (ev.type == SDL_RENDER_DEVICE_RESET)
+                clear_tile_layer();
             if (ev.type == SDL_QUIT)
                 ss->running = false;
         }
@@ -127,6 +179,13 @@ int main(int argc, char** argv) {
         if (!arg_headless)
             render();
 
+        // Lua GC in what is left of a fixed step's worth of frame, capped so
+        // an uncapped frame rate does not turn into a GC loop
+        {
+            double spent = static_cast<double>(SDL_GetPerformanceCounter() - t_now) / static_cast<double>(perf_freq);
+            luam->gc_step(std::min(0.002, static_cast<double>(TIMESTEP) - spent));
+        }
+
         // FPS calculation using high-resolution timer
         accum_sec += dt;
         frame_counter += 1;
@@ -141,6 +200,11 @@ int main(int argc, char** argv) {
             char tmp[32];
             std::snprintf(tmp, sizeof(tmp), "%d", last_fps);
             title_buf += tmp;
+            if (!arg_headless) {
+                std::snprintf(tmp, sizeof(tmp), " | drawn %u culled %u", gg->cull.frame_drawn(),
+                              gg->cull.frame_culled());
+                title_buf += tmp;
+            }
             if (!arg_headless)
                 SDL_SetWindowTitle(gg->window, title_buf.c_str());
         }
@@ -152,6 +216,9 @@ int main(int argc, char** argv) {
         }
     }
 
+    luam->log_hook_stats(10);
+    luam->log_memory_stats();
+    log_cull_stats();
     cleanup_audio();
     cleanup_mods_manager();
     cleanup_state();
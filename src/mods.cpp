@@ -2,6 +2,7 @@
 #include "globals.hpp"
 #include "settings.hpp"
 #include "graphics.hpp"
+#include "scripting_ticks.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -61,7 +62,7 @@ void discover_mods() {
 /// ignores transient `std::error_code`s during traversal.
 ///
 /// Calls `rebuild_sprite_registry(names)`, which nukes and replaces:
-///   - Graphics::sprite_name_to_id
+///   - Graphics::sprite_sym_to_id
 ///   - Graphics::sprite_id_to_name
 ///
 /// Does NOT parse manifests, build SpriteDef data, or load textures.
@@ -121,7 +122,7 @@ static bool is_image_ext(const std::string& ext) {
 /// replaces:
 ///   - `Graphics::sprite_defs_by_id`
 ///   - `Graphics::sprite_id_to_name`
-///   - `Graphics::sprite_name_to_id`
+///   - `Graphics::sprite_sym_to_id`
 ///
 /// Does NOT load textures. Log-and-continue on parse errors. Complexity
 /// O(files + parse). Call on startup and whenever manifests or image content
@@ -238,6 +239,9 @@ bool poll_fs_mods_hot_reload() {
         std::printf("[mods] Asset changes detected (%zu). Rebuilding sprites...\n",
                     changed_assets.size());
         scan_mods_for_sprite_defs();
+        // Sprite ids may have moved; a script reload below relinks anyway
+        if (luam && changed_scripts.empty())
+            luam->link();
     }
     if (!changed_scripts.empty()) {
         std::printf("[mods] Script changes detected (%zu). Reloading Lua...\n",
@@ -245,50 +249,52 @@ bool poll_fs_mods_hot_reload() {
         if (luam) {
             luam->load_mods();
             // Update existing entities from defs (sprite, sizes, and stats)
-            for (auto& e : ss->entities.data()) {
-                if (!e.active || e.def_type == 0) continue;
+            for (std::size_t id : ss->entities.active_ids()) {
+                auto& e = ss->entities.data()[id];
+                auto& st = ss->entities.cold(e).stats;
+                if (e.def_type == 0) continue;
                 if (const auto* ed = luam->find_entity_type(e.def_type)) {
                     // Visuals and collider
-                    e.sprite_id = -1;
-                    if (!ed->sprite.empty() && ed->sprite.find(':') != std::string::npos)
-                        e.sprite_id = try_get_sprite_id(ed->sprite);
+                    e.sprite_id = ed->sprite_id;
                     e.sprite_size = {ed->sprite_w, ed->sprite_h};
                     e.size = {ed->collider_w, ed->collider_h};
                     // Preserve ratios when changing caps
                     float hp_ratio = (e.max_hp > 0) ? ((float)e.health / (float)e.max_hp) : 0.0f;
-                    float sh_ratio = (e.stats.shield_max > 0.0f) ? (e.shield / e.stats.shield_max) : 0.0f;
+                    float sh_ratio = (st.shield_max > 0.0f) ? (e.shield / st.shield_max) : 0.0f;
                     // Core caps and regen
                     e.max_hp = ed->max_hp;
                     e.health = (uint32_t)std::lround(hp_ratio * (float)e.max_hp);
-                    e.stats.health_regen = ed->health_regen;
-                    e.stats.shield_max = ed->shield_max;
+                    st.health_regen = ed->health_regen;
+                    st.shield_max = ed->shield_max;
                     e.shield = ed->shield_max * sh_ratio;
-                    e.stats.shield_regen = ed->shield_regen;
+                    st.shield_regen = ed->shield_regen;
                     // Defense and movement
-                    e.stats.armor = ed->armor;
-                    e.stats.plates = ed->plates;
-                    e.stats.move_speed = ed->move_speed;
-                    e.stats.dodge = ed->dodge;
+                    st.armor = ed->armor;
+                    st.plates = ed->plates;
+                    st.move_speed = ed->move_speed;
+                    st.dodge = ed->dodge;
                     // Economy/modifiers
-                    e.stats.scavenging = ed->scavenging;
-                    e.stats.currency = ed->currency;
-                    e.stats.ammo_gain = ed->ammo_gain;
-                    e.stats.luck = ed->luck;
+                    st.scavenging = ed->scavenging;
+                    st.currency = ed->currency;
+                    st.ammo_gain = ed->ammo_gain;
+                    st.luck = ed->luck;
                     // Combat
-                    e.stats.crit_chance = ed->crit_chance;
-                    e.stats.crit_damage = ed->crit_damage;
-                    e.stats.headshot_damage = ed->headshot_damage;
-                    e.stats.damage_absorb = ed->damage_absorb;
-                    e.stats.damage_output = ed->damage_output;
-                    e.stats.healing = ed->healing;
-                    e.stats.accuracy = ed->accuracy;
-                    e.stats.terror_level = ed->terror_level;
+                    st.crit_chance = ed->crit_chance;
+                    st.crit_damage = ed->crit_damage;
+                    st.headshot_damage = ed->headshot_damage;
+                    st.damage_absorb = ed->damage_absorb;
+                    st.damage_output = ed->damage_output;
+                    st.healing = ed->healing;
+                    st.accuracy = ed->accuracy;
+                    st.terror_level = ed->terror_level;
                     // Movement spread dynamics
-                    e.stats.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
-                    e.stats.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
-                    e.stats.move_spread_max_deg = ed->move_spread_max_deg;
+                    st.move_spread_inc_rate_deg_per_sec_at_base = ed->move_spread_inc_rate_deg_per_sec_at_base;
+                    st.move_spread_decay_deg_per_sec = ed->move_spread_decay_deg_per_sec;
+                    st.move_spread_max_deg = ed->move_spread_max_deg;
                 }
             }
+            // Tick rates/phases may have changed
+            tick_rebuild_hosts();
             ss->alerts.push_back({"Lua reloaded", 0.0f, 1.5f, false});
         }
     }
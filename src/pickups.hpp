@@ -1,9 +1,10 @@
 #pragma once
 
+#include "pool.hpp"
+
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
-#include <vector>
 
 struct Pickup {
     bool active{false};
@@ -13,34 +14,17 @@ struct Pickup {
     int sprite_id{-1};
 };
 
-struct PickupsPool {
+struct PickupsPool : public Pool<Pickup, 1024> {
   public:
     static constexpr std::size_t MAX = 1024;
-    PickupsPool() {
-        items.resize(MAX);
-    }
     Pickup* spawn(uint32_t type, const std::string& name, glm::vec2 pos) {
-        for (auto& it : items)
-            if (!it.active) {
-                it.active = true;
-                it.type = type;
-                it.name = name;
-                it.pos = pos;
-                return &it;
-            }
-        return nullptr;
-    }
-    void clear() {
-        for (auto& it : items)
-            it.active = false;
+        auto v = alloc();
+        if (!v)
+            return nullptr;
+        Pickup* it = get(*v);
+        it->type = type;
+        it->name = name;
+        it->pos = pos;
+        return it;
     }
-    std::vector<Pickup>& data() {
-        return items;
-    }
-    const std::vector<Pickup>& data() const {
-        return items;
-    }
-
-  private:
-    std::vector<Pickup> items;
 };
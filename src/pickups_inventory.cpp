@@ -5,6 +5,7 @@
 #include "guns.hpp"
 #include "audio.hpp"
 #include "room.hpp"
+#include "scripting_ticks.hpp"
 #include "luamgr.hpp"
 #include "settings.hpp"
 
@@ -18,13 +19,16 @@ void auto_pickup_powerups() {
     glm::vec2 ph = p->half_size();
     float pl = p->pos.x - ph.x, pr = p->pos.x + ph.x;
     float pt = p->pos.y - ph.y, pb = p->pos.y + ph.y;
-    for (auto& pu : ss->pickups.data()) if (pu.active) {
+    auto slots = ss->pickups.active_slots();
+    for (std::size_t k = slots.size(); k-- > 0;) {
+        std::size_t slot = slots[k];
+        auto& pu = ss->pickups.data()[slot];
         float gl = pu.pos.x - 0.125f, gr = pu.pos.x + 0.125f;
         float gt = pu.pos.y - 0.125f, gb = pu.pos.y + 0.125f;
         bool overlap = !(pr <= gl || pl >= gr || pb <= gt || pt >= gb);
         if (overlap) {
             ss->alerts.push_back({std::string("Picked up ") + pu.name, 0.0f, 2.0f, false});
-            pu.active = false;
+            ss->pickups.release(slot);
             if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->powerups_picked += 1;
         }
     }
@@ -47,14 +51,14 @@ void handle_manual_pickups() {
             float yt = std::max(at, bt), yb = std::min(ab, bb);
             float w = xr - xl, h = yb - yt; if (w <= 0.0f || h <= 0.0f) return 0.0f; return w * h;
         };
-        for (std::size_t i = 0; i < ss->ground_guns.data().size(); ++i) {
-            auto const& ggun = ss->ground_guns.data()[i]; if (!ggun.active) continue;
+        for (std::size_t i : ss->ground_guns.active_slots()) {
+            auto const& ggun = ss->ground_guns.data()[i];
             glm::vec2 gh = ggun.size * 0.5f; float gl = ggun.pos.x - gh.x, gr = ggun.pos.x + gh.x; float gt = ggun.pos.y - gh.y, gb = ggun.pos.y + gh.y;
             float area = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
             if (area > best_area) { best_area = area; best_kind = PickKind::Gun; best_index = i; }
         }
-        for (std::size_t i = 0; i < ss->ground_items.data().size(); ++i) {
-            auto const& gi = ss->ground_items.data()[i]; if (!gi.active) continue;
+        for (std::size_t i : ss->ground_items.active_slots()) {
+            auto const& gi = ss->ground_items.data()[i];
             glm::vec2 gh = gi.size * 0.5f; float gl = gi.pos.x - gh.x, gr = gi.pos.x + gh.x; float gt = gi.pos.y - gh.y, gb = gi.pos.y + gh.y;
             float area = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
             if (area > best_area) { best_area = area; best_kind = PickKind::Item; best_index = i; }
@@ -63,14 +67,16 @@ void handle_manual_pickups() {
             auto& ggun = ss->ground_guns.data()[best_index];
             bool ok = false; if (auto* inv = (ss->player_vid ? ss->inv_for(*ss->player_vid) : nullptr)) ok = inv->insert_existing(INV_GUN, ggun.gun_vid);
             std::string nm = "gun";
-            if (luam) if (const GunInstance* gi = ss->guns.get(ggun.gun_vid)) for (auto const& g : luam->guns()) if (g.type == gi->def_type) { nm = g.name; break; }
+            if (luam) if (const GunInstance* gi = ss->guns.get(ggun.gun_vid)) if (const GunDef* g = luam->find_gun(gi->def_type)) nm = g->name;
             if (ok) {
-                ggun.active = false; did_pick = true; ss->alerts.push_back({std::string("Picked up ") + nm, 0.0f, 2.0f, false});
+                const VID gun_vid = ggun.gun_vid; // `ggun` is dead once its slot is released
+                tick_register_inv(INV_GUN, gun_vid, *ss->player_vid);
+                ss->ground_guns.release(best_index); did_pick = true; ss->alerts.push_back({std::string("Picked up ") + nm, 0.0f, 2.0f, false});
                 if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->guns_picked += 1;
-                if (const GunInstance* ggi = ss->guns.get(ggun.gun_vid)) {
-                    const GunDef* gd = nullptr; if (luam) for (auto const& g : luam->guns()) if (g.type == ggi->def_type) { gd = &g; break; }
+                if (const GunInstance* ggi = ss->guns.get(gun_vid)) {
+                    const GunDef* gd = luam ? luam->find_gun(ggi->def_type) : nullptr;
                     if (luam && ss->player_vid) if (auto* plent = ss->entities.get_mut(*ss->player_vid)) luam->call_gun_on_pickup(ggi->def_type, *plent);
-                    if (gd) play_sound(gd->sound_pickup.empty() ? "base:drop" : gd->sound_pickup); else play_sound("base:drop");
+                    if (gd) play_sound(gd->sound_pickup_id); else play_sound("base:drop"_sym);
                 }
             } else {
                 ss->alerts.push_back({"Inventory full", 0.0f, 1.5f, false});
@@ -78,7 +84,7 @@ void handle_manual_pickups() {
         } else if (best_kind == PickKind::Item) {
             auto& gi = ss->ground_items.data()[best_index];
             std::string nm = "item"; int maxc = 1; const ItemInstance* pick = ss->items.get(gi.item_vid);
-            if (luam && pick) { for (auto const& d : luam->items()) if (d.type == pick->def_type) { nm = d.name; maxc = d.max_count; break; } }
+            if (luam && pick) { if (const ItemDef* d = luam->find_item(pick->def_type)) { nm = d->name; maxc = d->max_count; } }
             bool fully_merged = false;
             if (pick) {
                 if (auto* inv = (ss->player_vid ? ss->inv_for(*ss->player_vid) : nullptr))
@@ -95,7 +101,7 @@ void handle_manual_pickups() {
                     tgt->count += xfer;
                     if (auto* pmut = ss->items.get(gi.item_vid)) pmut->count -= xfer;
                     if (auto* after = ss->items.get(gi.item_vid)) {
-                        if (after->count == 0) { ss->items.free(gi.item_vid); gi.active = false; fully_merged = true; }
+                        if (after->count == 0) { ss->items.free(gi.item_vid); ss->ground_items.release(best_index); fully_merged = true; }
                     }
                     if (xfer > 0) break;
                 }
@@ -103,10 +109,11 @@ void handle_manual_pickups() {
             if (!fully_merged) {
                 bool ok = false; if (auto* inv = (ss->player_vid ? ss->inv_for(*ss->player_vid) : nullptr)) ok = inv->insert_existing(INV_ITEM, gi.item_vid);
                 if (ok) {
-                    gi.active = false; did_pick = true; ss->alerts.push_back({std::string("Picked up ") + nm, 0.0f, 2.0f, false});
+                    tick_register_inv(INV_ITEM, gi.item_vid, *ss->player_vid);
+                    ss->ground_items.release(best_index); did_pick = true; ss->alerts.push_back({std::string("Picked up ") + nm, 0.0f, 2.0f, false});
                     if (luam && pick && ss->player_vid) if (auto* plent = ss->entities.get_mut(*ss->player_vid)) luam->call_item_on_pickup(pick->def_type, *plent);
-                    if (luam && pick) { const ItemDef* idf = nullptr; for (auto const& d : luam->items()) if (d.type == pick->def_type) { idf = &d; break; }
-                        if (idf) play_sound(idf->sound_pickup.empty() ? "base:drop" : idf->sound_pickup); else play_sound("base:drop"); }
+                    if (luam && pick) { const ItemDef* idf = luam->find_item(pick->def_type);
+                        if (idf) play_sound(idf->sound_pickup_id); else play_sound("base:drop"_sym); }
                     if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->items_picked += 1;
                 } else {
                     ss->alerts.push_back({std::string("Inventory full"), 0.0f, 1.5f, false});
@@ -119,8 +126,13 @@ void handle_manual_pickups() {
 }
 
 void separate_ground_items() {
-    for (auto& giA : ss->ground_items.data()) if (giA.active) {
-        for (auto& giB : ss->ground_items.data()) if (&giA != &giB && giB.active) {
+    auto item_slots = ss->ground_items.active_slots();
+    auto gun_slots = ss->ground_guns.active_slots();
+    for (std::size_t a : item_slots) {
+        auto& giA = ss->ground_items.data()[a];
+        for (std::size_t b : item_slots) {
+            if (a == b) continue;
+            auto& giB = ss->ground_items.data()[b];
             glm::vec2 ah = giA.size * 0.5f, bh = giB.size * 0.5f;
             bool overlap = !((giA.pos.x + ah.x) <= (giB.pos.x - bh.x) || (giA.pos.x - ah.x) >= (giB.pos.x + bh.x) || (giA.pos.y + ah.y) <= (giB.pos.y - bh.y) || (giA.pos.y - ah.y) >= (giB.pos.y + bh.y));
             if (overlap) {
@@ -130,8 +142,11 @@ void separate_ground_items() {
             }
         }
     }
-    for (auto& ga : ss->ground_guns.data()) if (ga.active) {
-        for (auto& gb : ss->ground_guns.data()) if (&ga != &gb && gb.active) {
+    for (std::size_t a : gun_slots) {
+        auto& ga = ss->ground_guns.data()[a];
+        for (std::size_t b : gun_slots) {
+            if (a == b) continue;
+            auto& gb = ss->ground_guns.data()[b];
             glm::vec2 ah = ga.size * 0.5f, bh = gb.size * 0.5f;
             bool overlap = !((ga.pos.x + ah.x) <= (gb.pos.x - bh.x) || (ga.pos.x - ah.x) >= (gb.pos.x + bh.x) || (ga.pos.y + ah.y) <= (gb.pos.y - bh.y) || (ga.pos.y - ah.y) >= (gb.pos.y + bh.y));
             if (overlap) {
@@ -141,9 +156,11 @@ void separate_ground_items() {
             }
         }
     }
-    for (auto& gi : ss->ground_items.data()) if (gi.active) {
+    for (std::size_t a : item_slots) {
+        auto& gi = ss->ground_items.data()[a];
         glm::vec2 ih = gi.size * 0.5f;
-        for (auto& ggun : ss->ground_guns.data()) if (ggun.active) {
+        for (std::size_t b : gun_slots) {
+            auto& ggun = ss->ground_guns.data()[b];
             glm::vec2 gh = ggun.size * 0.5f;
             bool overlap = !((gi.pos.x + ih.x) <= (ggun.pos.x - gh.x) || (gi.pos.x - ih.x) >= (ggun.pos.x + gh.x) || (gi.pos.y + ih.y) <= (ggun.pos.y - gh.y) || (gi.pos.y - ih.y) >= (ggun.pos.y + gh.y));
             if (overlap) {
@@ -153,9 +170,11 @@ void separate_ground_items() {
             }
         }
     }
-    for (auto& c : ss->crates.data()) if (c.active) {
+    for (std::size_t s : ss->crates.active_slots()) {
+        auto& c = ss->crates.data()[s];
         glm::vec2 ch = c.size * 0.5f;
-        for (auto& gi : ss->ground_items.data()) if (gi.active) {
+        for (std::size_t a : item_slots) {
+            auto& gi = ss->ground_items.data()[a];
             glm::vec2 ih = gi.size * 0.5f;
             bool overlap = !((gi.pos.x + ih.x) <= (c.pos.x - ch.x) || (gi.pos.x - ih.x) >= (c.pos.x + ch.x) || (gi.pos.y + ih.y) <= (c.pos.y - ch.y) || (gi.pos.y - ih.y) >= (c.pos.y + ch.y));
             if (overlap) {
@@ -164,7 +183,8 @@ void separate_ground_items() {
                 gi.pos += d * 0.012f;
             }
         }
-        for (auto& ggun : ss->ground_guns.data()) if (ggun.active) {
+        for (std::size_t b : gun_slots) {
+            auto& ggun = ss->ground_guns.data()[b];
             glm::vec2 gh = ggun.size * 0.5f;
             bool overlap = !((ggun.pos.x + gh.x) <= (c.pos.x - ch.x) || (ggun.pos.x - gh.x) >= (c.pos.x + ch.x) || (ggun.pos.y + gh.y) <= (c.pos.y - ch.y) || (ggun.pos.y - gh.y) >= (c.pos.y + ch.y));
             if (overlap) {
@@ -203,21 +223,23 @@ void handle_inventory_hotbar() {
                         glm::vec2 place_pos = ensure_not_in_block(p->pos);
                         if (ent->kind == INV_GUN) {
                             int gspr = -1; std::string nm = "gun";
-                            if (luam) { const GunInstance* gi = ss->guns.get(ent->vid); if (gi) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { nm = g.name; if (!g.sprite.empty() && g.sprite.find(':') != std::string::npos) gspr = try_get_sprite_id(g.sprite); else gspr = -1; break; } } }
-                            if (ss->player_vid) { Entity* pme = ss->entities.get_mut(*ss->player_vid); if (pme && pme->equipped_gun_vid.has_value() && pme->equipped_gun_vid->id == ent->vid.id && pme->equipped_gun_vid->version == ent->vid.version) { pme->equipped_gun_vid.reset(); } }
+                            if (luam) { const GunInstance* gi = ss->guns.get(ent->vid); if (gi) { if (const GunDef* g = luam->find_gun(gi->def_type)) { nm = g->name; gspr = g->sprite_id; } } }
+                            if (ss->player_vid) { Entity* pme = ss->entities.get_mut(*ss->player_vid); if (pme) { auto& eq = ss->entities.cold(*pme).equipped_gun_vid; if (eq && eq->id == ent->vid.id && eq->version == ent->vid.version) eq.reset(); } }
                             if (luam && ss->player_vid) if (const GunInstance* gi = ss->guns.get(ent->vid)) if (auto* plent = ss->entities.get_mut(*ss->player_vid)) luam->call_gun_on_drop(gi->def_type, *plent);
                             ss->ground_guns.spawn(ent->vid, place_pos, gspr);
                             if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->guns_dropped += 1;
+                            tick_unregister_inv(INV_GUN, ent->vid);
                             inv->remove_slot(idx);
                             ss->alerts.push_back({std::string("Dropped gun: ") + nm, 0.0f, 2.0f, false});
                         } else {
                             if (const ItemInstance* inst = ss->items.get(ent->vid)) {
                                 int def_type = inst->def_type; std::string nm = "item";
-                                if (luam) { for (auto const& d : luam->items()) if (d.type == def_type) { nm = d.name; break; } }
+                                if (luam) { if (const ItemDef* d = luam->find_item(def_type)) nm = d->name; }
                                 if (inst->count > 1) {
                                     if (auto* mut = ss->items.get(ent->vid)) { mut->count -= 1; }
                                     if (auto nv = ss->items.alloc()) { if (auto* newv = ss->items.get(*nv)) { newv->active = true; newv->def_type = def_type; newv->count = 1; ss->ground_items.spawn(*nv, place_pos); } }
                                 } else {
+                                    tick_unregister_inv(INV_ITEM, ent->vid);
                                     ss->ground_items.spawn(ent->vid, place_pos); inv->remove_slot(idx);
                                 }
                                 if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->items_dropped += 1;
@@ -229,7 +251,7 @@ void handle_inventory_hotbar() {
             } else {
                 if (!ent) { /* empty */ }
                 else if (ent->kind == INV_GUN) {
-                    if (ss->player_vid) { if (Entity* p = ss->entities.get_mut(*ss->player_vid)) { p->equipped_gun_vid = ent->vid; if (luam) { if (const GunInstance* gi = ss->guns.get(ent->vid)) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { ss->alerts.push_back({std::string("Equipped ") + g.name, 0.0f, 1.2f, false}); break; } } } } }
+                    if (ss->player_vid) { if (Entity* p = ss->entities.get_mut(*ss->player_vid)) { ss->entities.cold(*p).equipped_gun_vid = ent->vid; if (luam) { if (const GunInstance* gi = ss->guns.get(ent->vid)) { if (const GunDef* g = luam->find_gun(gi->def_type)) ss->alerts.push_back({std::string("Equipped ") + g->name, 0.0f, 1.2f, false}); } } } }
                 } else if (ent->kind == INV_ITEM) {
                     // just selects now
                 }
@@ -14,26 +14,24 @@
 #include <cmath>
 
 void update_shields_and_reload_progress() {
-    for (auto& e : ss->entities.data()) {
-        if (!e.active) continue;
-        if (e.stats.shield_max > 0.0f && e.time_since_damage >= 3.0f) {
-            float prev_ratio = (e.stats.shield_max > 0.0f) ? (e.shield / e.stats.shield_max) : 0.0f;
-            e.shield = std::min(e.stats.shield_max, e.shield + e.stats.shield_regen * TIMESTEP);
-            float ratio = (e.stats.shield_max > 0.0f) ? (e.shield / e.stats.shield_max) : 0.0f;
+    for (std::size_t id : ss->entities.active_ids()) {
+        auto& e = ss->entities.data()[id];
+        auto& ec = ss->entities.cold(e);
+        if (ec.stats.shield_max > 0.0f && e.time_since_damage >= 3.0f) {
+            float prev_ratio = (ec.stats.shield_max > 0.0f) ? (e.shield / ec.stats.shield_max) : 0.0f;
+            e.shield = std::min(ec.stats.shield_max, e.shield + ec.stats.shield_regen * TIMESTEP);
+            float ratio = (ec.stats.shield_max > 0.0f) ? (e.shield / ec.stats.shield_max) : 0.0f;
             if (luam && e.def_type) {
                 if (prev_ratio < 1.0f && ratio >= 1.0f) luam->call_entity_on_shield_full(e.def_type, e);
                 if (prev_ratio >= 0.5f && ratio < 0.5f) luam->call_entity_on_shield_under_50(e.def_type, e);
                 if (prev_ratio >= 0.25f && ratio < 0.25f) luam->call_entity_on_shield_under_25(e.def_type, e);
             }
-            e.last_shield_ratio = ratio;
+            ec.last_shield_ratio = ratio;
         }
-        if (e.type_ == ids::ET_PLAYER && e.equipped_gun_vid.has_value()) {
-            if (auto* gi = ss->guns.get(*e.equipped_gun_vid)) {
+        if (e.type_ == ids::ET_PLAYER && ec.equipped_gun_vid.has_value()) {
+            if (auto* gi = ss->guns.get(*ec.equipped_gun_vid)) {
                 if (gi->reloading) {
-                    const GunDef* gd = nullptr;
-                    if (luam) {
-                        for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-                    }
+                    const GunDef* gd = luam ? luam->find_gun(gi->def_type) : nullptr;
                     if (gi->reload_eject_remaining > 0.0f) {
                         gi->reload_eject_remaining = std::max(0.0f, gi->reload_eject_remaining - TIMESTEP);
                     } else if (gi->reload_total_time > 0.0f) {
@@ -63,19 +61,16 @@ void update_shields_and_reload_progress() {
 void update_reload_active() {
     if (!ss || ss->mode != ids::MODE_PLAYING || !ss->player_vid) return;
     auto* plm = ss->entities.get_mut(*ss->player_vid);
-    if (!plm || !plm->equipped_gun_vid.has_value()) return;
+    if (!ss->entities.equipped_gun(plm)) return;
     static bool prev_reload = false;
     bool now_reload = ss->playing_inputs.reload;
     if (now_reload && !prev_reload) {
-        GunInstance* gim = ss->guns.get(*plm->equipped_gun_vid);
+        GunInstance* gim = ss->guns.get(*ss->entities.equipped_gun(plm));
         if (gim) {
-            const GunDef* gd = nullptr;
-            if (luam) {
-                for (auto const& g : luam->guns()) if (g.type == gim->def_type) { gd = &g; break; }
-            }
+            const GunDef* gd = luam ? luam->find_gun(gim->def_type) : nullptr;
             if (gim->jammed) {
                 ss->alerts.push_back({"Gun jammed! Mash SPACE", 0.0f, 1.2f, false});
-                if (aa) play_sound("base:ui_cant");
+                if (aa) play_sound("base:ui_cant"_sym);
             } else if (gd) {
                 if (gim->reloading) {
                     float prog = gim->reload_progress;
@@ -90,7 +85,7 @@ void update_reload_active() {
                         gim->burst_timer = 0.0f;
                         ss->alerts.push_back({"Active Reload!", 0.0f, 1.2f, false});
                         ss->reticle_shake = std::max(ss->reticle_shake, 6.0f);
-                        if (aa) play_sound("base:ui_super_confirm");
+                        if (aa) play_sound("base:ui_super_confirm"_sym);
                         if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->active_reload_success += 1;
                         if (luam) {
                             luam->call_on_active_reload(*plm);
@@ -145,7 +140,7 @@ void update_reload_active() {
                     gim->ar_window_end = start + size;
                     gim->ar_consumed = false;
                     gim->ar_failed_attempt = false;
-                    if (aa) play_sound(gd->sound_reload.empty() ? "base:reload" : gd->sound_reload);
+                    if (aa) play_sound(gd->sound_reload_id);
                 } else {
                     ss->alerts.push_back({std::string("NO AMMO"), 0.0f, 1.5f, false});
                     if (plm->def_type && luam) luam->call_entity_on_out_of_ammo(plm->def_type, *plm);
@@ -171,14 +166,11 @@ void update_trigger_and_fire() {
     std::string fire_mode = "auto";
     if (ss->mode == ids::MODE_PLAYING && ss->player_vid) {
         auto* plm = ss->entities.get_mut(*ss->player_vid);
-        if (plm && plm->equipped_gun_vid.has_value()) {
-            const GunInstance* giq = ss->guns.get(*plm->equipped_gun_vid);
-            const GunDef* gdq = nullptr;
-            if (luam && giq) {
-                for (auto const& g : luam->guns()) if (g.type == giq->def_type) { gdq = &g; break; }
-            }
+        if (ss->entities.equipped_gun(plm)) {
+            const GunInstance* giq = ss->guns.get(*ss->entities.equipped_gun(plm));
+            const GunDef* gdq = (luam && giq) ? luam->find_gun(giq->def_type) : nullptr;
             if (gdq) { fire_mode = gdq->fire_mode; burst_count = gdq->burst_count; burst_rpm = gdq->burst_rpm; }
-            GunInstance* gimq = ss->guns.get(*plm->equipped_gun_vid);
+            GunInstance* gimq = ss->guns.get(*ss->entities.equipped_gun(plm));
             if (gimq) {
                 gimq->burst_timer = std::max(0.0f, gimq->burst_timer - TIMESTEP);
                 if (gdq) gimq->spread_recoil_deg = std::max(0.0f, gimq->spread_recoil_deg - gdq->control * TIMESTEP);
@@ -212,23 +204,19 @@ void update_trigger_and_fire() {
     int proj_type = 0;
     float proj_speed = 20.0f;
     glm::vec2 proj_size{0.2f, 0.2f};
-    int proj_steps = 2;
     int proj_sprite_id = -1;
     int ammo_type = 0;
     if (ss->player_vid) {
         auto* plm = ss->entities.get_mut(*ss->player_vid);
-        if (plm && plm->equipped_gun_vid.has_value()) {
-            const GunInstance* gi = ss->guns.get(*plm->equipped_gun_vid);
-            const GunDef* gd = nullptr;
-            if (luam && gi) {
-                for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-            }
+        if (ss->entities.equipped_gun(plm)) {
+            const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plm));
+            const GunDef* gd = (luam && gi) ? luam->find_gun(gi->def_type) : nullptr;
             if (gd && gi) {
                 rpm = (gd->rpm > 0.0f) ? gd->rpm : rpm;
                 if (luam && gd->projectile_type != 0) {
                     if (auto const* pd = luam->find_projectile(gd->projectile_type)) {
-                        proj_type = pd->type; proj_speed = pd->speed; proj_size = {pd->size_x, pd->size_y}; proj_steps = pd->physics_steps;
-                        if (!pd->sprite.empty() && pd->sprite.find(':') != std::string::npos) proj_sprite_id = try_get_sprite_id(pd->sprite);
+                        proj_type = pd->type; proj_speed = pd->speed; proj_size = {pd->size_x, pd->size_y};
+                        proj_sprite_id = pd->sprite_id;
                     }
                 }
                 ammo_type = gi->ammo_type;
@@ -236,13 +224,10 @@ void update_trigger_and_fire() {
                     if (auto const* ad = luam->find_ammo(ammo_type)) {
                         if (ad->speed > 0.0f) proj_speed = ad->speed;
                         proj_size = {ad->size_x, ad->size_y};
-                        if (!ad->sprite.empty() && ad->sprite.find(':') != std::string::npos) {
-                            int sid = try_get_sprite_id(ad->sprite);
-                            if (sid >= 0) proj_sprite_id = sid;
-                        }
+                        if (ad->sprite_id >= 0) proj_sprite_id = ad->sprite_id;
                     }
                 }
-                GunInstance* gim = ss->guns.get(*plm->equipped_gun_vid);
+                GunInstance* gim = ss->guns.get(*ss->entities.equipped_gun(plm));
                 if (gim->jammed || gim->reloading || gim->reload_eject_remaining > 0.0f) {
                     fired = false;
                 } else if (gim->current_mag > 0) {
@@ -251,9 +236,10 @@ void update_trigger_and_fire() {
                     fired = false;
                 }
                 if (fired) {
-                    float acc = std::max(0.1f, ss->entities.get(*ss->player_vid)->stats.accuracy / 100.0f);
+                    auto const& pc = ss->entities.cold(*plm);
+                    float acc = std::max(0.1f, pc.stats.accuracy / 100.0f);
                     float base_dev = (gd ? gd->deviation : 0.0f) / acc;
-                    float move_spread = ss->entities.get(*ss->player_vid)->move_spread_deg / acc;
+                    float move_spread = pc.move_spread_deg / acc;
                     float recoil_spread = gim->spread_recoil_deg;
                     float theta_deg = std::clamp(base_dev + move_spread + recoil_spread, MIN_SPREAD_DEG, MAX_SPREAD_DEG);
                     static thread_local std::mt19937 rng_theta{std::random_device{}()};
@@ -271,7 +257,7 @@ void update_trigger_and_fire() {
                     if (U(rng) < jc) {
                         gim->jammed = true; gim->unjam_progress = 0.0f; fired = false;
                         if (luam) { luam->call_gun_on_jam(gim->def_type, *plm); if (plm->def_type) luam->call_entity_on_gun_jam(plm->def_type, *plm); }
-                        if (aa) play_sound(gd->sound_jam.empty() ? "base:ui_cant" : gd->sound_jam);
+                        if (aa) play_sound(gd->sound_jam_id);
                         ss->alerts.push_back({"Gun jammed! Mash SPACE", 0.0f, 2.0f, false});
                         if (ss->player_vid) if (auto* pm = ss->metrics_for(*ss->player_vid)) pm->jams += 1;
                     }
@@ -285,9 +271,9 @@ void update_trigger_and_fire() {
         int pellets = 1;
         if (ss->player_vid) {
             auto* plm = ss->entities.get_mut(*ss->player_vid);
-            if (plm && plm->equipped_gun_vid.has_value()) {
-                if (const GunInstance* gi = ss->guns.get(*plm->equipped_gun_vid)) {
-                    const GunDef* gd = nullptr; if (luam) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; } }
+            if (ss->entities.equipped_gun(plm)) {
+                if (const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plm))) {
+                    const GunDef* gd = luam ? luam->find_gun(gi->def_type) : nullptr;
                     if (gd && gd->pellets_per_shot > 1) pellets = gd->pellets_per_shot;
                 }
             }
@@ -295,13 +281,14 @@ void update_trigger_and_fire() {
         float theta_deg_for_shot = 0.0f;
         if (ss->player_vid) {
             auto* plm = ss->entities.get_mut(*ss->player_vid);
-            if (plm && plm->equipped_gun_vid.has_value()) {
-                if (const GunInstance* gi = ss->guns.get(*plm->equipped_gun_vid)) {
-                    const GunDef* gd = nullptr; if (luam) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; } }
+            if (ss->entities.equipped_gun(plm)) {
+                if (const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plm))) {
+                    const GunDef* gd = luam ? luam->find_gun(gi->def_type) : nullptr;
                     if (gd) {
-                        float acc = std::max(0.1f, plm->stats.accuracy / 100.0f);
+                        auto const& pc = ss->entities.cold(*plm);
+                        float acc = std::max(0.1f, pc.stats.accuracy / 100.0f);
                         float base_dev = gd->deviation / acc;
-                        float move_spread = plm->move_spread_deg / acc;
+                        float move_spread = pc.move_spread_deg / acc;
                         float recoil_spread = const_cast<GunInstance*>(gi)->spread_recoil_deg;
                         theta_deg_for_shot = std::clamp(base_dev + move_spread + recoil_spread, MIN_SPREAD_DEG, MAX_SPREAD_DEG);
                     }
@@ -316,47 +303,48 @@ void update_trigger_and_fire() {
             glm::vec2 pdir{aim.x * cs - aim.y * sn, aim.x * sn + aim.y * cs};
             pdir = glm::normalize(pdir);
             glm::vec2 sp = p + pdir * GUN_MUZZLE_OFFSET_UNITS;
-            auto* pr = ss ? ss->projectiles.spawn(sp, pdir * proj_speed, proj_size, proj_steps, proj_type) : nullptr;
-            if (pr && ss->player_vid) pr->owner = ss->player_vid;
-            if (pr) {
-                pr->sprite_id = proj_sprite_id;
-                pr->ammo_type = ammo_type;
-                float base_dmg = 1.0f;
-                if (luam && ss->player_vid) {
-                    if (auto* plmm = ss->entities.get_mut(*ss->player_vid)) {
-                        if (plmm->equipped_gun_vid.has_value()) {
-                            if (const GunInstance* gi2 = ss->guns.get(*plmm->equipped_gun_vid)) {
-                                const GunDef* gd2 = nullptr; for (auto const& g : luam->guns()) if (g.type == gi2->def_type) { gd2 = &g; break; }
-                                if (gd2) base_dmg = gd2->damage;
-                            }
+            float base_dmg = 1.0f;
+            if (luam && ss->player_vid) {
+                if (auto* plmm = ss->entities.get_mut(*ss->player_vid)) {
+                    if (ss->entities.equipped_gun(plmm)) {
+                        if (const GunInstance* gi2 = ss->guns.get(*ss->entities.equipped_gun(plmm))) {
+                            const GunDef* gd2 = luam->find_gun(gi2->def_type);
+                            if (gd2) base_dmg = gd2->damage;
                         }
                     }
                 }
-                float dmg_mult = 1.0f, armor_pen = 0.0f, shield_mult = 1.0f, range_units = 0.0f;
-                if (luam && ammo_type != 0) {
-                    if (auto const* ad = luam->find_ammo(ammo_type)) {
-                        dmg_mult = ad->damage_mult; armor_pen = ad->armor_pen; shield_mult = ad->shield_mult; range_units = ad->range_units;
-                        pr->pierce_remaining = std::max(0, ad->pierce_count);
-                    }
+            }
+            float dmg_mult = 1.0f, armor_pen = 0.0f, shield_mult = 1.0f, range_units = 0.0f;
+            int pierce = 0;
+            if (luam && ammo_type != 0) {
+                if (auto const* ad = luam->find_ammo(ammo_type)) {
+                    dmg_mult = ad->damage_mult; armor_pen = ad->armor_pen; shield_mult = ad->shield_mult; range_units = ad->range_units;
+                    pierce = std::max(0, ad->pierce_count);
                 }
+            }
+            auto* pr = ss ? ss->projectiles.spawn(sp, pdir * proj_speed, proj_size, proj_type, range_units) : nullptr;
+            if (pr && ss->player_vid) pr->owner = ss->player_vid;
+            if (pr) {
+                pr->sprite_id = proj_sprite_id;
+                pr->ammo_type = ammo_type;
                 pr->base_damage = base_dmg * dmg_mult;
                 pr->armor_pen = armor_pen;
                 pr->shield_mult = shield_mult;
-                pr->max_range_units = range_units;
+                pr->pierce_remaining = pierce;
             }
             (void)pr;
         }
         if (ss->player_vid) {
             auto* plm = ss->entities.get_mut(*ss->player_vid);
-            if (plm && plm->equipped_gun_vid.has_value()) {
-                const GunInstance* gi = ss->guns.get(*plm->equipped_gun_vid);
-                const GunDef* gd = nullptr; if (luam && gi) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; } }
-                if (aa) play_sound((gd && !gd->sound_fire.empty()) ? gd->sound_fire : "base:small_shoot");
+            if (ss->entities.equipped_gun(plm)) {
+                const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plm));
+                const GunDef* gd = (luam && gi) ? luam->find_gun(gi->def_type) : nullptr;
+                if (aa) { if (gd) play_sound(gd->sound_fire_id); else play_sound("base:small_shoot"_sym); }
             } else {
-                if (aa) play_sound("base:small_shoot");
+                if (aa) play_sound("base:small_shoot"_sym);
             }
         } else {
-            if (aa) play_sound("base:small_shoot");
+            if (aa) play_sound("base:small_shoot"_sym);
         }
         if (luam && ss->player_vid) {
             auto* plm = ss->entities.get_mut(*ss->player_vid);
@@ -369,8 +357,8 @@ void update_trigger_and_fire() {
         if (ss->player_vid && fire_mode == "burst" && burst_step && burst_rpm > 0.0f) {
             ss->gun_cooldown = std::max(0.01f, 60.0f / burst_rpm);
             auto* plm2 = ss->entities.get_mut(*ss->player_vid);
-            if (plm2 && plm2->equipped_gun_vid.has_value()) {
-                if (auto* gim2 = ss->guns.get(*plm2->equipped_gun_vid)) {
+            if (ss->entities.equipped_gun(plm2)) {
+                if (auto* gim2 = ss->guns.get(*ss->entities.equipped_gun(plm2))) {
                     gim2->burst_remaining = std::max(0, gim2->burst_remaining - 1);
                     gim2->burst_timer = ss->gun_cooldown;
                 }
@@ -379,8 +367,8 @@ void update_trigger_and_fire() {
             ss->gun_cooldown = std::max(0.05f, 60.0f / rpm);
             if (ss->player_vid && fire_mode == "burst") {
                 auto* plm2 = ss->entities.get_mut(*ss->player_vid);
-                if (plm2 && plm2->equipped_gun_vid.has_value()) {
-                    auto* gim2 = ss->guns.get(*plm2->equipped_gun_vid);
+                if (ss->entities.equipped_gun(plm2)) {
+                    auto* gim2 = ss->guns.get(*ss->entities.equipped_gun(plm2));
                     if (gim2 && gim2->burst_remaining == 0) gim2->burst_timer = 0.0f;
                 }
             }
@@ -391,8 +379,8 @@ void update_trigger_and_fire() {
 void update_unjam() {
     if (!ss || !ss->player_vid || ss->mode != ids::MODE_PLAYING) return;
     auto* plm = ss->entities.get_mut(*ss->player_vid);
-    if (!plm || !plm->equipped_gun_vid.has_value()) return;
-    GunInstance* gim = ss->guns.get(*plm->equipped_gun_vid);
+    if (!ss->entities.equipped_gun(plm)) return;
+    GunInstance* gim = ss->guns.get(*ss->entities.equipped_gun(plm));
     if (!gim || !gim->jammed) return;
 
     static bool prev_space = false;
@@ -407,10 +395,7 @@ void update_unjam() {
         gim->jammed = false;
         gim->unjam_progress = 0.0f;
         ss->reticle_shake = std::max(ss->reticle_shake, 10.0f);
-        const GunDef* gd = nullptr;
-        if (luam) {
-            for (auto const& g : luam->guns()) if (g.type == gim->def_type) { gd = &g; break; }
-        }
+        const GunDef* gd = luam ? luam->find_gun(gim->def_type) : nullptr;
         if (gd) {
             if (gim->ammo_reserve > 0) {
                 int dropped = gim->current_mag;
@@ -434,7 +419,7 @@ void update_unjam() {
                 gim->ar_window_end = start2 + size2;
                 gim->ar_consumed = false;
                 ss->alerts.push_back({"Unjammed: Reloading...", 0.0f, 1.0f, false});
-                if (aa) play_sound("base:unjam");
+                if (aa) play_sound("base:unjam"_sym);
             } else {
                 ss->alerts.push_back({"Unjammed: NO AMMO", 0.0f, 1.5f, false});
             }
@@ -9,9 +9,9 @@
 #include <random>
 
 void update_movement_and_collision() {
-    for (auto& e : ss->entities.data()) {
-        if (!e.active)
-            continue;
+    for (std::size_t id : ss->entities.active_ids()) {
+        auto& e = ss->entities.data()[id];
+        auto& ec = ss->entities.cold(e);
         e.time_since_damage += TIMESTEP;
         if (e.type_ == ids::ET_PLAYER) {
             glm::vec2 dir{0.0f, 0.0f};
@@ -21,7 +21,7 @@ void update_movement_and_collision() {
             if (ss->playing_inputs.down)  dir.y += 1.0f;
             if (dir.x != 0.0f || dir.y != 0.0f)
                 dir = glm::normalize(dir);
-            float scale = (e.stats.move_speed > 0.0f) ? (e.stats.move_speed / 350.0f) : 1.0f;
+            float scale = (ec.stats.move_speed > 0.0f) ? (ec.stats.move_speed / 350.0f) : 1.0f;
             ss->dash_timer = std::max(0.0f, ss->dash_timer - TIMESTEP);
             if (ss->dash_stocks < ss->dash_max) {
                 ss->dash_refill_timer += TIMESTEP;
@@ -58,11 +58,11 @@ void update_movement_and_collision() {
                 float spd = std::sqrt(e.vel.x * e.vel.x + e.vel.y * e.vel.y);
                 float factor = std::clamp(spd / PLAYER_SPEED_UNITS_PER_SEC, 0.0f, 4.0f);
                 if (factor > 0.01f) {
-                    e.move_spread_deg = std::min(e.stats.move_spread_max_deg,
-                        e.move_spread_deg + e.stats.move_spread_inc_rate_deg_per_sec_at_base * factor * TIMESTEP);
+                    ec.move_spread_deg = std::min(ec.stats.move_spread_max_deg,
+                        ec.move_spread_deg + ec.stats.move_spread_inc_rate_deg_per_sec_at_base * factor * TIMESTEP);
                 } else {
-                    e.move_spread_deg = std::max(0.0f,
-                        e.move_spread_deg - e.stats.move_spread_decay_deg_per_sec * TIMESTEP);
+                    ec.move_spread_deg = std::max(0.0f,
+                        ec.move_spread_deg - ec.stats.move_spread_decay_deg_per_sec * TIMESTEP);
                 }
             }
             if (ss->dash_timer > 0.0f) {
@@ -98,12 +98,7 @@ void update_movement_and_collision() {
                 glm::vec2 tl = {next_x - half.x, e.pos.y - half.y};
                 glm::vec2 br = {next_x + half.x, e.pos.y + half.y};
                 int minx = (int)floorf(tl.x), miny = (int)floorf(tl.y), maxx = (int)floorf(br.x), maxy = (int)floorf(br.y);
-                bool blocked = false;
-                for (int ty = miny; ty <= maxy && !blocked; ++ty)
-                    for (int tx = minx; tx <= maxx; ++tx) {
-                        if (!ss->stage.in_bounds(tx, ty)) { blocked = true; break; }
-                        if (ss->stage.at(tx, ty).blocks_entities()) { blocked = true; break; }
-                    }
+                bool blocked = ss->stage.any_blocked(minx, miny, maxx, maxy, MASK_BLOCKS_ENTITIES, true);
                 if (!blocked) e.pos.x = next_x; else e.vel.x = 0.0f;
             }
             // Y axis
@@ -113,12 +108,7 @@ void update_movement_and_collision() {
                 glm::vec2 tl = {e.pos.x - half.x, next_y - half.y};
                 glm::vec2 br = {e.pos.x + half.x, next_y + half.y};
                 int minx = (int)floorf(tl.x), miny = (int)floorf(tl.y), maxx = (int)floorf(br.x), maxy = (int)floorf(br.y);
-                bool blocked = false;
-                for (int ty = miny; ty <= maxy && !blocked; ++ty)
-                    for (int tx = minx; tx <= maxx; ++tx) {
-                        if (!ss->stage.in_bounds(tx, ty)) { blocked = true; break; }
-                        if (ss->stage.at(tx, ty).blocks_entities()) { blocked = true; break; }
-                    }
+                bool blocked = ss->stage.any_blocked(minx, miny, maxx, maxy, MASK_BLOCKS_ENTITIES, true);
                 if (!blocked) e.pos.y = next_y; else e.vel.y = 0.0f;
             }
         }
@@ -6,26 +6,37 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 
+// Fixed-capacity slot pool with generational ids. Free slots form a stack
+// (O(1) alloc/release); live slots are also kept in a dense list for
+// iteration. A VID stays valid until its slot is released.
+//
+// T must have a `bool active` member. Slots must be released through the
+// pool (free/release/clear), never by clearing `active` directly.
 template <typename T, std::size_t N> struct Pool {
   public:
     Pool() {
         versions_.fill(1);
+        reset_lists();
     }
 
     std::size_t capacity() const {
         return N;
     }
+    std::size_t size() const {
+        return dense_count_;
+    }
 
     std::optional<VID> alloc() {
-        for (std::size_t i = 0; i < N; ++i) {
-            if (!items_[i].active) {
-                items_[i] = T{};
-                items_[i].active = true;
-                return VID{i, versions_[i]};
-            }
-        }
-        return std::nullopt;
+        if (free_top_ == 0)
+            return std::nullopt;
+        std::uint32_t i = free_[--free_top_];
+        items_[i] = T{};
+        items_[i].active = true;
+        dense_pos_[i] = static_cast<std::uint32_t>(dense_count_);
+        dense_[dense_count_++] = i;
+        return VID{i, versions_[i]};
     }
 
     void free(VID v) {
@@ -33,8 +44,29 @@ template <typename T, std::size_t N> struct Pool {
             return;
         if (versions_[v.id] != v.version)
             return;
-        items_[v.id].active = false;
-        versions_[v.id] += 1; // invalidate stale refs
+        release(v.id);
+    }
+
+    // Release by slot index (for callers iterating data() or active_slots()).
+    void release(std::size_t i) {
+        if (i >= N || !items_[i].active)
+            return;
+        items_[i].active = false;
+        versions_[i] += 1; // invalidate stale refs
+        // Swap-remove from the dense list
+        std::uint32_t pos = dense_pos_[i];
+        std::uint32_t last = dense_[--dense_count_];
+        dense_[pos] = last;
+        dense_pos_[last] = pos;
+        free_[free_top_++] = static_cast<std::uint32_t>(i);
+    }
+
+    void clear() {
+        for (std::size_t k = 0; k < dense_count_; ++k) {
+            items_[dense_[k]].active = false;
+            versions_[dense_[k]] += 1;
+        }
+        reset_lists();
     }
 
     T* get(VID v) {
@@ -57,6 +89,16 @@ template <typename T, std::size_t N> struct Pool {
         return &items_[v.id];
     }
 
+    VID vid_at(std::size_t i) const {
+        return VID{i, versions_[i]};
+    }
+
+    // Slot indices of live items, unordered. Releasing the slot being visited
+    // is safe when walking back to front; allocations append past the view.
+    std::span<const std::uint32_t> active_slots() const {
+        return {dense_.data(), dense_count_};
+    }
+
     // Raw access (useful for iteration/cleanup)
     std::array<T, N>& data() {
         return items_;
@@ -66,6 +108,19 @@ template <typename T, std::size_t N> struct Pool {
     }
 
   private:
+    void reset_lists() {
+        // Lowest slot on top, so a fresh pool hands out 0, 1, 2, ...
+        for (std::size_t k = 0; k < N; ++k)
+            free_[k] = static_cast<std::uint32_t>(N - 1 - k);
+        free_top_ = N;
+        dense_count_ = 0;
+    }
+
     std::array<T, N> items_{};
     std::array<uint32_t, N> versions_{};
+    std::array<std::uint32_t, N> free_{};
+    std::array<std::uint32_t, N> dense_{};
+    std::array<std::uint32_t, N> dense_pos_{};
+    std::size_t free_top_{0};
+    std::size_t dense_count_{0};
 };
@@ -63,8 +63,9 @@ void start_score_review_if_ready() {
             std::uint64_t total_shots_fired = 0, total_shots_hit = 0;
             std::uint64_t total_enemies_slain = ss->metrics.enemies_slain;
             std::uint64_t total_powerups_picked = 0, total_items_picked = 0, total_guns_picked = 0, total_items_dropped = 0, total_guns_dropped = 0, total_damage_dealt = 0;
-            for (auto const& e : ss->entities.data()) {
-                if (!e.active || e.type_ != ids::ET_PLAYER) continue;
+            for (std::size_t id : ss->entities.active_ids()) {
+                auto const& e = ss->entities.data()[id];
+                if (e.type_ != ids::ET_PLAYER) continue;
                 const auto* pm = ss->metrics_for(e.vid); if (!pm) continue;
                 total_shots_fired += pm->shots_fired; total_shots_hit += pm->shots_hit;
                 total_powerups_picked += pm->powerups_picked; total_items_picked += pm->items_picked; total_guns_picked += pm->guns_picked; total_items_dropped += pm->items_dropped; total_guns_dropped += pm->guns_dropped; total_damage_dealt += pm->damage_dealt;
@@ -92,8 +93,9 @@ void start_score_review_if_ready() {
             add_stat("Missed items", (double)missed_items);
             add_stat("Missed guns", (double)missed_guns);
             int pidx = 1;
-            for (auto const& e : ss->entities.data()) {
-                if (!e.active || e.type_ != ids::ET_PLAYER) continue;
+            for (std::size_t id : ss->entities.active_ids()) {
+                auto const& e = ss->entities.data()[id];
+                if (e.type_ != ids::ET_PLAYER) continue;
                 const auto* pm = ss->metrics_for(e.vid); if (!pm) continue;
                 char hdr[32]; std::snprintf(hdr, sizeof(hdr), "Player %d", pidx++);
                 add_header(hdr);
@@ -125,8 +127,10 @@ void start_score_review_if_ready() {
 }
 
 static void cleanup_ground_instances() {
-    for (auto& gi : ss->ground_items.data()) if (gi.active) { ss->items.free(gi.item_vid); gi.active = false; }
-    for (auto& ggun : ss->ground_guns.data()) if (ggun.active) { ss->guns.free(ggun.gun_vid); ggun.active = false; }
+    for (std::size_t i : ss->ground_items.active_slots()) ss->items.free(ss->ground_items.data()[i].item_vid);
+    for (std::size_t i : ss->ground_guns.active_slots()) ss->guns.free(ss->ground_guns.data()[i].gun_vid);
+    ss->ground_items.clear();
+    ss->ground_guns.clear();
 }
 
 void process_score_review_advance() {
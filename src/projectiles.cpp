@@ -0,0 +1,256 @@
+// Projectile integration kernel, tile sweep and lane resolution.
+// Responsibility: advance packed projectile lanes by one tick, find the first
+// blocking tile along a move, and resolve each lane's tick (free move or
+// swept narrow phase) for Projectiles::step.
+#include "projectiles.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GUB_PROJECTILES_SSE2 1
+#endif
+
+// Each lane moves by vel * dt; the narrow phase computes a clear move with
+// the same expressions, so a projectile's path is bit-identical whichever
+// route it takes.
+void integrate_projectiles(std::size_t n, float dt,
+                           const float* px, const float* py, const float* vx, const float* vy,
+                           const float* dist, float* out_x, float* out_y, float* out_dist) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    const __m256 vdt = _mm256_set1_ps(dt);
+    for (; i + 8 <= n; i += 8) {
+        __m256 sx = _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt);
+        __m256 sy = _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt);
+        __m256 sl = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(sx, sx), _mm256_mul_ps(sy, sy)));
+        _mm256_storeu_ps(out_x + i, _mm256_add_ps(_mm256_loadu_ps(px + i), sx));
+        _mm256_storeu_ps(out_y + i, _mm256_add_ps(_mm256_loadu_ps(py + i), sy));
+        _mm256_storeu_ps(out_dist + i, _mm256_add_ps(_mm256_loadu_ps(dist + i), sl));
+    }
+#elif defined(GUB_PROJECTILES_SSE2)
+    const __m128 vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= n; i += 4) {
+        __m128 sx = _mm_mul_ps(_mm_loadu_ps(vx + i), vdt);
+        __m128 sy = _mm_mul_ps(_mm_loadu_ps(vy + i), vdt);
+        __m128 sl = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy)));
+        _mm_storeu_ps(out_x + i, _mm_add_ps(_mm_loadu_ps(px + i), sx));
+        _mm_storeu_ps(out_y + i, _mm_add_ps(_mm_loadu_ps(py + i), sy));
+        _mm_storeu_ps(out_dist + i, _mm_add_ps(_mm_loadu_ps(dist + i), sl));
+    }
+#endif
+    for (; i < n; ++i) {
+        float sx = vx[i] * dt, sy = vy[i] * dt;
+        out_x[i] = px[i] + sx;
+        out_y[i] = py[i] + sy;
+        out_dist[i] = dist[i] + std::sqrt(sx * sx + sy * sy);
+    }
+}
+
+namespace {
+
+constexpr float NEVER = std::numeric_limits<float>::infinity();
+
+// One axis of a box sweep. [c0, c1] is the covered tile range (floor of
+// each edge, like the static overlap test); as the box moves the leading
+// edge enters new tiles and the trailing edge leaves old ones.
+struct SweepAxis {
+    float lo, hi, d;
+    int c0, c1;
+    float t_enter{NEVER}, t_leave{NEVER};
+
+    SweepAxis(float lo_, float hi_, float d_)
+        : lo(lo_), hi(hi_), d(d_), c0(static_cast<int>(std::floor(lo_))), c1(static_cast<int>(std::floor(hi_))) {
+        update();
+    }
+    void update() {
+        if (d > 0.0f) {
+            t_enter = (static_cast<float>(c1 + 1) - hi) / d;
+            t_leave = (static_cast<float>(c0 + 1) - lo) / d;
+        } else if (d < 0.0f) {
+            t_enter = (static_cast<float>(c0) - lo) / d;
+            t_leave = (static_cast<float>(c1) - hi) / d;
+        }
+    }
+    // Returns the tile index just entered.
+    int enter() {
+        int c = d > 0.0f ? ++c1 : --c0;
+        update();
+        return c;
+    }
+    void leave() {
+        if (d > 0.0f)
+            ++c0;
+        else
+            --c1;
+        update();
+    }
+};
+
+bool tiles_blocked(const Stage& stage, glm::vec2 tl, glm::vec2 br) {
+    return stage.any_blocked(static_cast<int>(std::floor(tl.x)), static_cast<int>(std::floor(tl.y)),
+                             static_cast<int>(std::floor(br.x)), static_cast<int>(std::floor(br.y)),
+                             MASK_BLOCKS_PROJECTILES, false);
+}
+
+// Narrow [t_in, t_out] to the times the moving interval [lo, hi] + d*t
+// overlaps [elo, ehi] (closed, like the static overlap test).
+bool slab(float lo, float hi, float d, float elo, float ehi, float& t_in, float& t_out) {
+    if (d == 0.0f)
+        return !(hi < elo || lo > ehi);
+    float t0 = (elo - hi) / d, t1 = (ehi - lo) / d;
+    if (t0 > t1)
+        std::swap(t0, t1);
+    t_in = std::max(t_in, t0);
+    t_out = std::min(t_out, t1);
+    return t_in <= t_out;
+}
+
+} // namespace
+
+std::optional<float> sweep_tiles(const Stage& stage, glm::vec2 pos, glm::vec2 half, glm::vec2 d) {
+    auto blocked = [&](int x0, int y0, int x1, int y1) {
+        return stage.any_blocked(x0, y0, x1, y1, MASK_BLOCKS_PROJECTILES, false);
+    };
+    SweepAxis ax(pos.x - half.x, pos.x + half.x, d.x);
+    SweepAxis ay(pos.y - half.y, pos.y + half.y, d.y);
+    if (blocked(ax.c0, ay.c0, ax.c1, ay.c1))
+        return 0.0f;
+    for (;;) {
+        float t = std::min(std::min(ax.t_enter, ax.t_leave), std::min(ay.t_enter, ay.t_leave));
+        if (!(t <= 1.0f))
+            return std::nullopt;
+        // Apply every crossing at this instant (leaves first), then test only
+        // the strips that became covered against the other axis' range.
+        if (ax.t_leave == t)
+            ax.leave();
+        if (ay.t_leave == t)
+            ay.leave();
+        bool ex = ax.t_enter == t, ey = ay.t_enter == t;
+        int nx = ex ? ax.enter() : 0;
+        int ny = ey ? ay.enter() : 0;
+        if ((ex && blocked(nx, ay.c0, nx, ay.c1)) || (ey && blocked(ax.c0, ny, ax.c1, ny)))
+            return t;
+    }
+}
+
+void Projectiles::resolve(float dt, const Stage& stage, const std::vector<Entity>& ents, const EntityGrid& grid,
+                          WorkerPool* pool) {
+    std::size_t n = count;
+    next_x.resize(n);
+    next_y.resize(n);
+    next_dist.resize(n);
+    std::size_t threads = pool ? pool->threads() : 1;
+    chunk_count = 1;
+    if (threads > 1)
+        chunk_count = std::clamp((n + MIN_CHUNK - 1) / MIN_CHUNK, std::size_t{1}, threads * CHUNKS_PER_THREAD);
+    if (chunks.size() < chunk_count)
+        chunks.resize(chunk_count);
+    auto run_chunk = [&](std::size_t c) {
+        chunks[c].events.clear();
+        resolve_range(n * c / chunk_count, n * (c + 1) / chunk_count, dt, stage, ents, grid, chunks[c]);
+    };
+    if (pool && chunk_count > 1)
+        pool->run(chunk_count, run_chunk);
+    else
+        run_chunk(0);
+}
+
+void Projectiles::resolve_range(std::size_t begin, std::size_t end, float dt, const Stage& stage,
+                                const std::vector<Entity>& ents, const EntityGrid& grid, Chunk& chunk) {
+    integrate_projectiles(end - begin, dt, pos_x.data() + begin, pos_y.data() + begin, vel_x.data() + begin,
+                          vel_y.data() + begin, dist.data() + begin, next_x.data() + begin,
+                          next_y.data() + begin, next_dist.data() + begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        // Pad slightly so rounding in the narrow phase never leaves the box
+        float px = half_x[i] + SWEEP_PAD, py = half_y[i] + SWEEP_PAD;
+        glm::vec2 tl{std::min(pos_x[i], next_x[i]) - px, std::min(pos_y[i], next_y[i]) - py};
+        glm::vec2 br{std::max(pos_x[i], next_x[i]) + px, std::max(pos_y[i], next_y[i]) + py};
+        if (tiles_blocked(stage, tl, br) || grid.any(tl, br)) {
+            step_narrow(i, dt, stage, ents, grid, chunk);
+            continue;
+        }
+        if (max_range[i] > 0.0f && next_dist[i] >= max_range[i]) {
+            alive[i] = 0;
+            continue;
+        }
+        pos_x[i] = next_x[i];
+        pos_y[i] = next_y[i];
+        dist[i] = next_dist[i];
+    }
+}
+
+void Projectiles::step_narrow(std::size_t i, float dt, const Stage& stage, const std::vector<Entity>& ents,
+                              const EntityGrid& grid, Chunk& chunk) {
+    Projectile& pr = info_[i];
+    std::uint32_t lane = static_cast<std::uint32_t>(i);
+    glm::vec2 pos{pos_x[i], pos_y[i]};
+    glm::vec2 half{half_x[i], half_y[i]};
+    // Same expressions as integrate_projectiles, so a clear move lands
+    // exactly where the free path would have put it
+    glm::vec2 d{vel_x[i] * dt, vel_y[i] * dt};
+    glm::vec2 end{pos.x + d.x, pos.y + d.y};
+    float len = std::sqrt(d.x * d.x + d.y * d.y);
+    // The move ends early at the first blocking tile or at max range,
+    // whichever comes first; entities entered before that point are hit.
+    float t_stop = 1.0f;
+    bool range_end = false;
+    if (max_range[i] > 0.0f && dist[i] + len >= max_range[i]) {
+        range_end = true;
+        t_stop = len > 0.0f ? std::max(0.0f, (max_range[i] - dist[i]) / len) : 0.0f;
+    }
+    std::optional<float> t_tile = sweep_tiles(stage, pos, half, d);
+    bool tile_end = t_tile && *t_tile < t_stop;
+    if (tile_end) {
+        t_stop = *t_tile;
+        range_end = false;
+    }
+    // Broadphase: entities near the whole tick's swept AABB, in slot order
+    grid.query(glm::min(pos, end) - half, glm::max(pos, end) + half, chunk.hit_candidates);
+    chunk.entries.clear();
+    for (std::uint32_t eid : chunk.hit_candidates) {
+        auto const& e = ents[eid];
+        if (!e.active) continue;
+        if (pr.owner && pr.owner->id == e.vid.id && pr.owner->version == e.vid.version)
+            continue;
+        glm::vec2 eh = e.half_size();
+        float t_in = 0.0f, t_out = 1.0f;
+        if (!slab(pos.x - half.x, pos.x + half.x, d.x, e.pos.x - eh.x, e.pos.x + eh.x, t_in, t_out) ||
+            !slab(pos.y - half.y, pos.y + half.y, d.y, e.pos.y - eh.y, e.pos.y + eh.y, t_in, t_out))
+            continue;
+        // A move that runs its full length keeps the closed end (touching
+        // at t = 1 is a hit, as in the static test); a cut-short one stops
+        // just before the wall or range limit
+        if ((!tile_end && !range_end) || t_in < t_stop)
+            chunk.entries.push_back({t_in, eid});
+    }
+    // Time of entry, ties in slot order
+    std::stable_sort(chunk.entries.begin(), chunk.entries.end(),
+                     [](const EntityEntry& a, const EntityEntry& b) { return a.t < b.t; });
+    for (const EntityEntry& en : chunk.entries) {
+        float travelled = dist[i] + len * en.t;
+        chunk.events.push_back({lane, en.eid, travelled});
+        if (pr.pierce_remaining > 0) {
+            pr.pierce_remaining -= 1;
+            continue;
+        }
+        kill_at(i, pos + d * en.t, travelled);
+        return;
+    }
+    if (tile_end) {
+        chunk.events.push_back({lane, TILE_HIT, dist[i] + len * t_stop});
+        kill_at(i, pos + d * t_stop, dist[i] + len * t_stop);
+        return;
+    }
+    if (range_end) {
+        kill_at(i, pos + d * t_stop, max_range[i]);
+        return;
+    }
+    pos_x[i] = end.x;
+    pos_y[i] = end.y;
+    dist[i] += len;
+}
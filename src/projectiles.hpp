@@ -1,21 +1,25 @@
 #pragma once
 
 #include "entity.hpp"
+#include "entity_grid.hpp"
+#include "settings.hpp"
 #include "stage.hpp"
 #include "types.hpp"
+#include "worker_pool.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <optional>
+#include <utility>
 #include <vector>
 
+// Cold per-projectile data: written at spawn, read on hit and draw.
+// Kinematics live in the SoA arrays of Projectiles.
 struct Projectile {
-    bool active{false};
-    glm::vec2 pos{0.0f, 0.0f};
-    glm::vec2 vel{0.0f, 0.0f};
-    glm::vec2 size{0.25f, 0.25f};
     float rot{0.0f};
     int sprite_id{-1};
-    int physics_steps{1};
     std::optional<VID> owner{};
     int def_type{0};
     // Ammo context
@@ -23,113 +27,184 @@ struct Projectile {
     float base_damage{1.0f};
     float armor_pen{0.0f}; // 0..1
     float shield_mult{1.0f};
-    float distance_travelled{0.0f};
-    float max_range_units{0.0f}; // 0 => unlimited
     int pierce_remaining{0}; // entities this projectile can still pass through
 };
 
+// Whole-tick integration over n packed lanes: next position and distance
+// travelled. SIMD where available (projectiles.cpp), scalar tail otherwise.
+void integrate_projectiles(std::size_t n, float dt,
+                           const float* px, const float* py, const float* vx, const float* vy,
+                           const float* dist, float* out_x, float* out_y, float* out_dist);
+
+// Earliest fraction t in [0, 1] of the move `d` at which the box
+// [pos - half, pos + half] overlaps a tile that blocks projectiles, or
+// nothing if the whole move is clear. Walks tile boundaries in time order
+// (a box-sized DDA) and tests only the row/column strip entered at each
+// crossing, so cost scales with tiles crossed rather than with substeps.
+std::optional<float> sweep_tiles(const Stage& stage, glm::vec2 pos, glm::vec2 half, glm::vec2 d);
+
+// Structure-of-arrays projectile store. Live projectiles are packed in
+// [0, size()) in spawn order; dead ones are compacted out (order preserved)
+// at the end of each step, so hit callbacks stay in a deterministic order.
 struct Projectiles {
   public:
-    static constexpr std::size_t MAX = 1024;
-    Projectiles() : items(MAX) {
+    explicit Projectiles(std::size_t cap = static_cast<std::size_t>(MAX_PROJECTILES)) {
+        set_capacity(cap);
     }
 
-    Projectile* spawn(glm::vec2 p, glm::vec2 v, glm::vec2 sz, int steps = 1, int def_type = 0) {
-        for (auto& pr : items) {
-            if (!pr.active) {
-                pr.active = true;
-                pr.pos = p;
-                pr.vel = v;
-                pr.size = sz;
-                pr.physics_steps = steps;
-                pr.def_type = def_type;
-                pr.distance_travelled = 0.0f;
-                pr.max_range_units = 0.0f;
-                pr.ammo_type = 0;
-                pr.base_damage = 1.0f;
-                pr.armor_pen = 0.0f;
-                pr.shield_mult = 1.0f;
-                pr.pierce_remaining = 0;
-                return &pr;
-            }
-        }
-        return nullptr;
+    std::size_t size() const {
+        return count;
+    }
+    std::size_t capacity() const {
+        return cap_;
+    }
+    // Shrinking below size() drops the newest projectiles.
+    void set_capacity(std::size_t cap) {
+        cap_ = cap;
+        count = std::min(count, cap_);
+        for (auto* v : {&pos_x, &pos_y, &vel_x, &vel_y, &half_x, &half_y, &dist, &max_range})
+            v->resize(cap_);
+        info_.resize(cap_);
+        alive.resize(cap_);
+    }
+
+    // Returns the cold record of the new projectile (valid until the next
+    // step or clear), or nullptr when at capacity.
+    Projectile* spawn(glm::vec2 p, glm::vec2 v, glm::vec2 sz, int def_type = 0, float max_range_units = 0.0f) {
+        if (count >= cap_)
+            return nullptr;
+        std::size_t i = count++;
+        pos_x[i] = p.x;
+        pos_y[i] = p.y;
+        vel_x[i] = v.x;
+        vel_y[i] = v.y;
+        half_x[i] = 0.5f * sz.x;
+        half_y[i] = 0.5f * sz.y;
+        dist[i] = 0.0f;
+        max_range[i] = max_range_units; // 0 => unlimited
+        alive[i] = 1;
+        info_[i] = Projectile{};
+        info_[i].def_type = def_type;
+        return &info_[i];
     }
 
     void clear() {
-        for (auto& pr : items)
-            pr.active = false;
+        count = 0;
     }
 
+    glm::vec2 pos(std::size_t i) const {
+        return {pos_x[i], pos_y[i]};
+    }
+    glm::vec2 vel(std::size_t i) const {
+        return {vel_x[i], vel_y[i]};
+    }
+    glm::vec2 size(std::size_t i) const {
+        return {2.0f * half_x[i], 2.0f * half_y[i]};
+    }
+    float distance_travelled(std::size_t i) const {
+        return dist[i];
+    }
+    const Projectile& info(std::size_t i) const {
+        return info_[i];
+    }
+
+    // 1) integrate every lane for the whole tick; 2) projectiles whose swept
+    // box touches no blocking tile and no occupied grid cell commit that
+    // result directly; 3) the rest resolve the tick with an exact swept
+    // test: first blocking tile, range limit and entity entries, handled in
+    // time order. Piercing is applied here (pierce_remaining), so lanes are
+    // independent and split into contiguous chunks across `pool` (nullptr =>
+    // this thread). Hits are buffered per chunk and replayed through the
+    // callbacks afterwards, on this thread and in lane order, so the result
+    // is identical for any thread count.
     template <typename HitEntityFn, typename HitTileFn>
     void step(float dt,
               const Stage& stage,
               const std::vector<Entity>& ents,
-              HitEntityFn&& on_hit,        // bool(Projectile&, const Entity&)
-              HitTileFn&& on_hit_tile) {   // void(Projectile&)
-        for (auto& pr : items) {
-            if (!pr.active) continue;
-            int steps = std::max(1, pr.physics_steps);
-            glm::vec2 step_dpos = pr.vel * (dt / static_cast<float>(steps));
-            for (int s = 0; s < steps; ++s) {
-                pr.distance_travelled += std::sqrt(step_dpos.x*step_dpos.x + step_dpos.y*step_dpos.y);
-                if (pr.max_range_units > 0.0f && pr.distance_travelled >= pr.max_range_units) {
-                    pr.active = false; break;
-                }
-                // X axis
-                glm::vec2 next = pr.pos;
-                next.x += step_dpos.x;
-                {
-                    glm::vec2 half = 0.5f * pr.size;
-                    glm::vec2 tl = {next.x - half.x, pr.pos.y - half.y};
-                    glm::vec2 br = {next.x + half.x, pr.pos.y + half.y};
-                    int minx = (int)std::floor(tl.x), miny = (int)std::floor(tl.y);
-                    int maxx = (int)std::floor(br.x), maxy = (int)std::floor(br.y);
-                    bool blocked = false;
-                    for (int y = miny; y <= maxy && !blocked; ++y)
-                        for (int x = minx; x <= maxx; ++x)
-                            if (stage.in_bounds(x, y) && stage.at(x, y).blocks_projectiles())
-                                blocked = true;
-                    if (blocked) { on_hit_tile(pr); pr.active = false; break; }
-                    pr.pos.x = next.x;
-                }
-                if (!pr.active) break;
-                // Y axis
-                next.y += step_dpos.y;
-                {
-                    glm::vec2 half = 0.5f * pr.size;
-                    glm::vec2 tl = {pr.pos.x - half.x, next.y - half.y};
-                    glm::vec2 br = {pr.pos.x + half.x, next.y + half.y};
-                    int minx = (int)std::floor(tl.x), miny = (int)std::floor(tl.y);
-                    int maxx = (int)std::floor(br.x), maxy = (int)std::floor(br.y);
-                    bool blocked = false;
-                    for (int y = miny; y <= maxy && !blocked; ++y)
-                        for (int x = minx; x <= maxx; ++x)
-                            if (stage.in_bounds(x, y) && stage.at(x, y).blocks_projectiles())
-                                blocked = true;
-                    if (blocked) { on_hit_tile(pr); pr.active = false; break; }
-                    pr.pos.y = next.y;
-                }
-                if (!pr.active) break;
-                // Entities
-                for (auto const& e : ents) {
-                    if (!e.active) continue;
-                    if (pr.owner && pr.owner->id == e.vid.id && pr.owner->version == e.vid.version)
-                        continue;
-                    glm::vec2 eh = e.half_size();
-                    glm::vec2 etl = e.pos - eh, ebr = e.pos + eh;
-                    glm::vec2 half = 0.5f * pr.size;
-                    glm::vec2 tl = pr.pos - half, br = pr.pos + half;
-                    bool overlap = !(br.x < etl.x || tl.x > ebr.x || br.y < etl.y || tl.y > ebr.y);
-                    if (overlap) {
-                        bool stop = on_hit(pr, e);
-                        if (stop) { pr.active = false; break; }
-                    }
-                }
-                if (!pr.active) break;
+              const EntityGrid& grid,
+              WorkerPool* pool,
+              HitEntityFn&& on_hit,        // void(const Projectile&, float distance_travelled, const Entity&)
+              HitTileFn&& on_hit_tile) {   // void(const Projectile&)
+        resolve(dt, stage, ents, grid, pool);
+        for (std::size_t c = 0; c < chunk_count; ++c) {
+            for (const HitEvent& ev : chunks[c].events) {
+                if (ev.eid == TILE_HIT)
+                    on_hit_tile(std::as_const(info_[ev.lane]));
+                else
+                    on_hit(std::as_const(info_[ev.lane]), ev.travelled, ents[ev.eid]);
+            }
+        }
+        compact();
+    }
+
+  private:
+    static constexpr float SWEEP_PAD = 1e-3f;
+    static constexpr std::uint32_t TILE_HIT = ~std::uint32_t{0};
+    static constexpr std::size_t CHUNKS_PER_THREAD = 4; // slack for uneven narrow-phase cost
+    static constexpr std::size_t MIN_CHUNK = 64;        // lanes; smaller batches aren't worth a handoff
+
+    struct EntityEntry {
+        float t;
+        std::uint32_t eid;
+    };
+    struct HitEvent {
+        std::uint32_t lane;
+        std::uint32_t eid; // TILE_HIT for the tile that stopped the lane
+        float travelled;
+    };
+    // Per-chunk output and scratch; a chunk is only ever touched by one thread.
+    struct Chunk {
+        std::vector<HitEvent> events;
+        std::vector<std::uint32_t> hit_candidates; // broadphase scratch, reused per projectile
+        std::vector<EntityEntry> entries;          // narrow-phase entity entries, reused per projectile
+    };
+
+    // Integrate, classify and resolve every lane (projectiles.cpp).
+    void resolve(float dt, const Stage& stage, const std::vector<Entity>& ents, const EntityGrid& grid,
+                 WorkerPool* pool);
+    void resolve_range(std::size_t begin, std::size_t end, float dt, const Stage& stage,
+                       const std::vector<Entity>& ents, const EntityGrid& grid, Chunk& chunk);
+    void step_narrow(std::size_t i, float dt, const Stage& stage, const std::vector<Entity>& ents,
+                     const EntityGrid& grid, Chunk& chunk);
+
+    void kill_at(std::size_t i, glm::vec2 p, float travelled) {
+        pos_x[i] = p.x;
+        pos_y[i] = p.y;
+        dist[i] = travelled;
+        alive[i] = 0;
+    }
+
+    // Stable in-place removal of dead lanes.
+    void compact() {
+        std::size_t w = 0;
+        for (std::size_t r = 0; r < count; ++r) {
+            if (!alive[r])
+                continue;
+            if (w != r) {
+                pos_x[w] = pos_x[r];
+                pos_y[w] = pos_y[r];
+                vel_x[w] = vel_x[r];
+                vel_y[w] = vel_y[r];
+                half_x[w] = half_x[r];
+                half_y[w] = half_y[r];
+                dist[w] = dist[r];
+                max_range[w] = max_range[r];
+                info_[w] = info_[r];
+                alive[w] = 1;
             }
+            ++w;
         }
+        count = w;
     }
 
-    std::vector<Projectile> items;
+    std::size_t count{0};
+    std::size_t cap_{0};
+    // Hot kinematics, one lane per live projectile
+    std::vector<float> pos_x, pos_y, vel_x, vel_y, half_x, half_y, dist, max_range;
+    std::vector<std::uint8_t> alive;
+    std::vector<Projectile> info_;
+    // Per-step scratch
+    std::vector<float> next_x, next_y, next_dist;
+    std::vector<Chunk> chunks; // grows to the largest chunk count seen
+    std::size_t chunk_count{0};
 };
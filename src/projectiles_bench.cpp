@@ -0,0 +1,124 @@
+#include "projectiles_bench.hpp"
+
+#include "entities.hpp"
+#include "entity_grid.hpp"
+#include "projectiles.hpp"
+#include "settings.hpp"
+#include "stage.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr std::uint32_t BENCH_W = 160;
+constexpr std::uint32_t BENCH_H = 90;
+constexpr std::size_t BENCH_PROJECTILES = 16384;
+constexpr int BENCH_NPCS = 600;
+constexpr int BENCH_TICKS = 720;
+
+struct BenchResult {
+    double ms_per_tick{0.0};
+    double grid_ms_per_tick{0.0}; // EntityGrid::build, the per-tick pass over every Entity
+    std::size_t entity_hits{0};
+    std::size_t tile_hits{0};
+    std::uint64_t hash{14695981039346656037ull}; // FNV-1a over the replayed hits
+};
+
+void mix(std::uint64_t& h, const void* data, std::size_t n) {
+    auto const* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+}
+
+// Same seed for every run, so each thread count sees the same room, the
+// same NPCs and the same spawn sequence.
+BenchResult run_once(std::size_t threads) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> U(0.0f, 1.0f);
+    Stage stage(BENCH_W, BENCH_H);
+    stage.fill_border(TileProps::Make(true, true));
+    for (std::uint32_t k = 0; k < BENCH_W * BENCH_H / 12; ++k) {
+        int x = 1 + static_cast<int>(U(rng) * static_cast<float>(BENCH_W - 2));
+        int y = 1 + static_cast<int>(U(rng) * static_cast<float>(BENCH_H - 2));
+        stage.set(x, y, TileProps::Make(true, U(rng) < 0.6f));
+    }
+    auto ents = std::make_unique<Entities>();
+    for (int k = 0; k < BENCH_NPCS; ++k) {
+        auto vid = ents->new_entity();
+        if (!vid)
+            break;
+        Entity* e = ents->get_mut(*vid);
+        e->pos = {1.0f + U(rng) * static_cast<float>(BENCH_W - 2), 1.0f + U(rng) * static_cast<float>(BENCH_H - 2)};
+        float s = 0.25f + U(rng) * 0.75f;
+        e->size = {s, s};
+    }
+    EntityGrid grid;
+
+    WorkerPool pool(threads);
+    Projectiles projectiles(BENCH_PROJECTILES);
+    BenchResult r{};
+    auto on_hit = [&](const Projectile& pr, float travelled, const Entity& e) {
+        r.entity_hits += 1;
+        mix(r.hash, &pr.def_type, sizeof(pr.def_type));
+        mix(r.hash, &e.vid.id, sizeof(e.vid.id));
+        mix(r.hash, &travelled, sizeof(travelled));
+    };
+    auto on_hit_tile = [&](const Projectile& pr) {
+        r.tile_hits += 1;
+        mix(r.hash, &pr.def_type, sizeof(pr.def_type));
+    };
+    int next_id = 1;
+    std::chrono::steady_clock::duration spent{}, grid_spent{};
+    for (int tick = 0; tick < BENCH_TICKS; ++tick) {
+        // Rebuilt every tick, as step_projectiles_and_hits does
+        auto g0 = std::chrono::steady_clock::now();
+        grid.build(stage, *ents);
+        grid_spent += std::chrono::steady_clock::now() - g0;
+        while (projectiles.size() < projectiles.capacity()) {
+            glm::vec2 p{1.0f + U(rng) * static_cast<float>(BENCH_W - 2), 1.0f + U(rng) * static_cast<float>(BENCH_H - 2)};
+            float a = U(rng) * 6.2831853f, sp = 10.0f + U(rng) * 90.0f;
+            Projectile* pr = projectiles.spawn(p, {std::cos(a) * sp, std::sin(a) * sp}, {0.12f, 0.12f}, next_id++,
+                                               U(rng) < 0.3f ? 4.0f + U(rng) * 20.0f : 0.0f);
+            pr->pierce_remaining = static_cast<int>(U(rng) * 3.0f);
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        projectiles.step(TIMESTEP, stage, ents->data(), grid, &pool, on_hit, on_hit_tile);
+        spent += std::chrono::steady_clock::now() - t0;
+    }
+    r.ms_per_tick = std::chrono::duration<double, std::milli>(spent).count() / BENCH_TICKS;
+    r.grid_ms_per_tick = std::chrono::duration<double, std::milli>(grid_spent).count() / BENCH_TICKS;
+    return r;
+}
+
+} // namespace
+
+int run_projectile_bench(int max_threads) {
+    if (max_threads <= 0)
+        max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("[bench] projectiles=%zu npcs=%d ticks=%d stage=%ux%u sizeof(Entity)=%zu\n", BENCH_PROJECTILES,
+                BENCH_NPCS, BENCH_TICKS, BENCH_W, BENCH_H, sizeof(Entity));
+    BenchResult base{};
+    int rc = 0;
+    for (int t = 1; t <= max_threads; ++t) {
+        BenchResult r = run_once(static_cast<std::size_t>(t));
+        if (t == 1)
+            base = r;
+        bool same = r.hash == base.hash && r.entity_hits == base.entity_hits && r.tile_hits == base.tile_hits;
+        if (!same)
+            rc = 1;
+        std::printf("[bench] threads=%d ms/tick=%.3f speedup=%.2fx grid ms/tick=%.4f hits=%zu tiles=%zu hash=%016llx %s\n",
+                    t, r.ms_per_tick, base.ms_per_tick / r.ms_per_tick, r.grid_ms_per_tick, r.entity_hits, r.tile_hits,
+                    static_cast<unsigned long long>(r.hash), same ? "same" : "DIVERGED");
+    }
+    return rc;
+}
@@ -0,0 +1,8 @@
+// Projectile stepping benchmark (--bench-projectiles=N).
+// Responsibility: time Projectiles::step on a synthetic room at 1..N worker
+// threads and check that every thread count produces the same hit stream.
+#pragma once
+
+// Prints one line per thread count; returns nonzero if any run diverged
+// from the single-threaded one.
+int run_projectile_bench(int max_threads);
@@ -5,9 +5,12 @@
 #include "luamgr.hpp"
 #include "sprites.hpp"
 #include "settings.hpp"
+#include "sprite_batch.hpp"
+#include "text.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <random>
 #include <string>
 #include <vector>
@@ -22,22 +25,9 @@ static inline void ui_draw_kv_line(int tx, int& ty, int lh,
                                    const char* key, const std::string& value,
                                    SDL_Color key_color = SDL_Color{150,150,150,255},
                                    SDL_Color val_color = SDL_Color{230,230,230,255}) {
-    SDL_Renderer* renderer = gg ? gg->renderer : nullptr;
-    TTF_Font* font = gg ? gg->ui_font : nullptr;
-    if (!renderer || !font) return;
-    SDL_Surface* ks = TTF_RenderUTF8_Blended(font, (std::string(key)+": ").c_str(), key_color);
-    int keyw=0,keyh=0; SDL_Texture* kt=nullptr;
-    if (ks) { kt = SDL_CreateTextureFromSurface(renderer, ks);
-        SDL_QueryTexture(kt,nullptr,nullptr,&keyw,&keyh);
-        SDL_Rect kd{tx, ty, keyw, keyh}; SDL_RenderCopy(renderer, kt, nullptr, &kd);
-        SDL_DestroyTexture(kt); SDL_FreeSurface(ks);
-    }
-    SDL_Surface* vs = TTF_RenderUTF8_Blended(font, value.c_str(), val_color);
-    if (vs) { SDL_Texture* vt = SDL_CreateTextureFromSurface(renderer, vs);
-        int vw=0,vh=0; SDL_QueryTexture(vt,nullptr,nullptr,&vw,&vh);
-        SDL_Rect vd{tx+keyw, ty, vw, vh}; SDL_RenderCopy(renderer, vt, nullptr, &vd);
-        SDL_DestroyTexture(vt); SDL_FreeSurface(vs);
-    }
+    if (!gg || !gg->renderer || !gg->ui_font) return;
+    SDL_Rect kd = draw_text(std::string(key) + ": ", tx, ty, key_color);
+    draw_text(value, tx + kd.w, ty, val_color);
     ty += lh;
 }
 }
@@ -61,6 +51,9 @@ void render() {
         if (std::find(frame_warnings.begin(), frame_warnings.end(), s) == frame_warnings.end())
             frame_warnings.push_back(s);
     };
+    // Dangling sprite keys are logged once at link time; show only a count
+    if (luam && luam->unresolved_refs() > 0)
+        add_warning(std::to_string(luam->unresolved_refs()) + " unresolved sprite/sound refs (see log)");
 
     // Fetch output size each frame
     SDL_GetRendererOutputSize(renderer, &width, &height);
@@ -70,40 +63,22 @@ void render() {
         float sy = (wy - gg->play_cam.pos.y) * scale + static_cast<float>(height) * 0.5f;
         return SDL_FPoint{sx, sy};
     };
+    // World-space view; each world pass skips what lies outside it
+    const ViewRect view = view_rect(gg->play_cam.pos, TILE_SIZE * gg->play_cam.zoom, width, height);
+    auto px_to_world = [&](float px) { return px / (TILE_SIZE * gg->play_cam.zoom); };
+    CullStats& cull = gg->cull;
 
-    if (ss->mode == ids::MODE_PLAYING) {
-        // draw tiles
-        for (int y = 0; y < (int)ss->stage.get_height(); ++y) {
-            for (int x = 0; x < (int)ss->stage.get_width(); ++x) {
-                const auto& t = ss->stage.at(x, y);
-                bool is_start = (x == ss->start_tile.x && y == ss->start_tile.y);
-                bool is_exit = (x == ss->exit_tile.x && y == ss->exit_tile.y);
-                if (t.blocks_entities() || t.blocks_projectiles() || is_start || is_exit) {
-                    if (is_start)
-                        SDL_SetRenderDrawColor(renderer, 80, 220, 90, 255);
-                    else if (is_exit)
-                        SDL_SetRenderDrawColor(renderer, 240, 220, 80, 255);
-                    else if (t.blocks_entities() && t.blocks_projectiles())
-                        SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255); // wall
-                    else if (t.blocks_entities() && !t.blocks_projectiles())
-                        SDL_SetRenderDrawColor(renderer, 70, 90, 160, 255); // void/water
-                    else
-                        SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255);
-                    SDL_FPoint p0 = world_to_screen(static_cast<float>(x), static_cast<float>(y));
-                    float scale = TILE_SIZE * gg->play_cam.zoom;
-                    SDL_Rect tr{(int)std::floor(p0.x), (int)std::floor(p0.y),
-                                (int)std::ceil(scale), (int)std::ceil(scale)};
-                    SDL_RenderFillRect(renderer, &tr);
-                }
-            }
-        }
-    }
+    if (ss->mode == ids::MODE_PLAYING)
+        draw_tile_layer(width, height);
 
     // Draw crates (visuals only); open progression computed in sim
     if (ss->mode == ids::MODE_PLAYING) {
-        for (auto& c : ss->crates.data())
-            if (c.active && !c.opened) {
+        const ViewRect crate_view = view.padded(px_to_world(160.0f)); // label and bar overhang
+        for (std::size_t slot : ss->crates.active_slots())
+            if (auto& c = ss->crates.data()[slot]; !c.opened) {
                 glm::vec2 ch = c.size * 0.5f;
+                if (!cull.count(CULL_CRATES, crate_view.overlaps(c.pos, ch)))
+                    continue;
                 // world → screen rect
                 SDL_FPoint c0 = world_to_screen(c.pos.x - ch.x, c.pos.y - ch.y);
                 float scale = TILE_SIZE * gg->play_cam.zoom;
@@ -119,16 +94,8 @@ void render() {
                     if (auto const* cd = luam->find_crate(c.def_type))
                         label = cd->label.empty() ? cd->name : cd->label;
                     SDL_Color lc{240, 220, 80, 255};
-                    SDL_Surface* lsrf = TTF_RenderUTF8_Blended(gg->ui_font, label.c_str(), lc);
-                    if (lsrf) {
-                        SDL_Texture* lt = SDL_CreateTextureFromSurface(renderer, lsrf);
-                        int tw = 0, th = 0;
-                        SDL_QueryTexture(lt, nullptr, nullptr, &tw, &th);
-                        SDL_Rect ld{rc.x + (rc.w - tw) / 2, rc.y - th - 18, tw, th};
-                        SDL_RenderCopy(renderer, lt, nullptr, &ld);
-                        SDL_DestroyTexture(lt);
-                        SDL_FreeSurface(lsrf);
-                    }
+                    SDL_Point ts = measure_text(label);
+                    draw_text(label, rc.x + (rc.w - ts.x) / 2, rc.y - ts.y - 18, lc);
                 }
                 // progress bar above (visual ratio from open_progress/open_time)
                 float open_time = 5.0f;
@@ -151,69 +118,69 @@ void render() {
             }
     }
 
-    // draw entities (only during gameplay)
-    if (ss->mode == ids::MODE_PLAYING)
-        for (auto const& e : ss->entities.data()) {
-            if (!e.active)
+    // draw entities (only during gameplay). Sprites and fallback boxes go
+    // through the sprite batch; the outlines and the held gun draw on top.
+    if (ss->mode == ids::MODE_PLAYING) {
+        static std::vector<SDL_Rect> sprite_bounds, collider_bounds; // static: keeps capacity
+        sprite_bounds.clear();
+        collider_bounds.clear();
+        bool held_gun = false;
+        SpriteTex held_tex{};
+        SDL_Rect held_r{};
+        float held_angle = 0.0f;
+        for (std::size_t id : ss->entities.active_ids()) {
+            auto const& e = ss->entities.data()[id];
+            // Sprite or collider, whichever is larger; the player's box also
+            // covers the held gun
+            glm::vec2 eh = glm::max(e.draw_size(), e.size) * 0.5f;
+            if (e.type_ == ids::ET_PLAYER)
+                eh += glm::vec2{GUN_HOLD_OFFSET_UNITS + 0.15f};
+            if (!cull.count(CULL_ENTITIES, view.overlaps(e.pos, eh)))
                 continue;
             // sprite if available
             bool drew_sprite = false;
             if (e.sprite_id >= 0) {
-                SDL_Texture* tex = get_texture(e.sprite_id);
+                SpriteTex tex = get_sprite_tex(e.sprite_id);
                 if (tex) {
-                    int tw = 0, th = 0;
-                    SDL_QueryTexture(tex, nullptr, nullptr, &tw, &th);
                     glm::vec2 ds = e.draw_size();
                     SDL_FPoint c = world_to_screen(e.pos.x - ds.x * 0.5f, e.pos.y - ds.y * 0.5f);
                     float scale = TILE_SIZE * gg->play_cam.zoom;
                     SDL_Rect dst{(int)std::floor(c.x), (int)std::floor(c.y),
                                  (int)std::ceil(ds.x * scale), (int)std::ceil(ds.y * scale)};
-                    SDL_RenderCopy(renderer, tex, nullptr, &dst);
+                    batch_sprite(tex, dst);
                     drew_sprite = true;
                     // Overlay: light grey sprite bounds
-                    SDL_SetRenderDrawColor(renderer, 180, 180, 180, 120);
-                    SDL_RenderDrawRect(renderer, &dst);
+                    sprite_bounds.push_back(dst);
                     // Overlay: red collider bounds
                     glm::vec2 ch = e.size;
                     SDL_FPoint c2 = world_to_screen(e.pos.x - ch.x * 0.5f, e.pos.y - ch.y * 0.5f);
-                    SDL_Rect coll{(int)std::floor(c2.x), (int)std::floor(c2.y),
-                                  (int)std::ceil(ch.x * scale), (int)std::ceil(ch.y * scale)};
-                    SDL_SetRenderDrawColor(renderer, 220, 60, 60, 160);
-                    SDL_RenderDrawRect(renderer, &coll);
+                    collider_bounds.push_back(SDL_Rect{(int)std::floor(c2.x), (int)std::floor(c2.y),
+                                                       (int)std::ceil(ch.x * scale), (int)std::ceil(ch.y * scale)});
                 } else {
                     add_warning("Missing texture for entity sprite");
                 }
             }
             // debug AABB
             if (!drew_sprite) {
-                add_warning("Missing sprite for entity");
+                SDL_Color col{180, 180, 200, 255};
                 if (e.type_ == ids::ET_PLAYER)
-                    SDL_SetRenderDrawColor(renderer, 60, 140, 240, 255);
+                    col = SDL_Color{60, 140, 240, 255};
                 else if (e.type_ == ids::ET_NPC)
-                    SDL_SetRenderDrawColor(renderer, 220, 60, 60, 255);
-                else
-                    SDL_SetRenderDrawColor(renderer, 180, 180, 200, 255);
+                    col = SDL_Color{220, 60, 60, 255};
                 glm::vec2 ds = e.draw_size();
                 SDL_FPoint c = world_to_screen(e.pos.x - ds.x * 0.5f, e.pos.y - ds.y * 0.5f);
                 float scale = TILE_SIZE * gg->play_cam.zoom;
                 SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
                            (int)std::ceil(ds.x * scale), (int)std::ceil(ds.y * scale)};
-                SDL_RenderFillRect(renderer, &r);
+                batch_fill(r, col);
             }
             // Player held gun: rotate sprite around player towards mouse
             if (e.type_ == ids::ET_PLAYER) {
                 const Entity* pl = &e;
-                if (pl->equipped_gun_vid.has_value() && luam) {
-                    const GunInstance* gi = ss->guns.get(*pl->equipped_gun_vid);
-                    const GunDef* gd = nullptr;
-                    if (gi) {
-                        for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-                    }
-                    int gspr = -1;
-                    if (gd) {
-                        if (!gd->sprite.empty() && gd->sprite.find(':') != std::string::npos)
-                            gspr = try_get_sprite_id(gd->sprite);
-                    }
+                if (ss->entities.equipped_gun(pl) && luam) {
+                    const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(pl));
+                    const GunDef* gd = gi ? luam->find_gun(gi->def_type) : nullptr;
+                    int gspr = gd ? gd->sprite_id : -1;
                     // Compute aim angle and world position under mouse
                     int ww = width, wh = height;
                     SDL_GetRendererOutputSize(renderer, &ww, &wh);
@@ -229,24 +196,47 @@ void render() {
                     float scale = TILE_SIZE * gg->play_cam.zoom;
                     SDL_Rect r{(int)std::floor(c0.x), (int)std::floor(c0.y), (int)std::ceil(0.30f * scale), (int)std::ceil(0.20f * scale)};
                     if (gspr >= 0) {
-                        if (SDL_Texture* tex = get_texture(gspr))
-                            SDL_RenderCopyEx(renderer, tex, nullptr, &r, angle_deg, nullptr, SDL_FLIP_NONE);
-                        else
+                        if (SpriteTex tex = get_sprite_tex(gspr)) {
+                            held_gun = true;
+                            held_tex = tex;
+                            held_r = r;
+                            held_angle = angle_deg;
+                        } else {
                             add_warning("Missing texture for held gun sprite");
+                        }
                     } else {
-                        add_warning("Missing sprite for held gun");
-                        SDL_SetRenderDrawColor(renderer, 180, 180, 200, 255);
-                        SDL_RenderFillRect(renderer, &r);
+                        held_gun = true;
+                        held_r = r;
                     }
                 }
             }
         }
+        flush_sprite_batch();
+        if (!sprite_bounds.empty()) {
+            SDL_SetRenderDrawColor(renderer, 180, 180, 180, 120);
+            SDL_RenderDrawRects(renderer, sprite_bounds.data(), (int)sprite_bounds.size());
+            SDL_SetRenderDrawColor(renderer, 220, 60, 60, 160);
+            SDL_RenderDrawRects(renderer, collider_bounds.data(), (int)collider_bounds.size());
+        }
+        if (held_gun) {
+            if (held_tex)
+                batch_sprite(held_tex, held_r, held_angle);
+            else
+                batch_fill(held_r, SDL_Color{180, 180, 200, 255});
+            flush_sprite_batch();
+        }
+    }
 
     // Enemy health bars above heads (for damaged NPCs)
     if (ss->mode == ids::MODE_PLAYING) {
-        for (auto const& e : ss->entities.data()) {
-            if (!e.active || e.type_ != ids::ET_NPC)
+        const ViewRect bar_view = view.padded(px_to_world(32.0f)); // bars stack up to ~30px above the head
+        for (std::size_t id : ss->entities.active_ids()) {
+            auto const& e = ss->entities.data()[id];
+            if (e.type_ != ids::ET_NPC)
+                continue;
+            if (!cull.count(CULL_HEALTH_BARS, bar_view.overlaps(e.pos, e.draw_size() * 0.5f)))
                 continue;
+            auto const& st = ss->entities.cold(e).stats;
             // Always show bars; if max_hp is zero, skip HP bar but keep slivers if any
             glm::vec2 ds = e.draw_size();
             SDL_FPoint c = world_to_screen(e.pos.x - ds.x * 0.5f, e.pos.y - ds.y * 0.5f);
@@ -267,8 +257,8 @@ void render() {
                 SDL_RenderFillRect(renderer, &hr);
             }
             // Optional shield indicator as thin cyan band just above the HP bar
-            if (e.stats.shield_max > 0.0f && e.shield > 0.0f) {
-                float sratio = std::clamp(e.shield / e.stats.shield_max, 0.0f, 1.0f);
+            if (st.shield_max > 0.0f && e.shield > 0.0f) {
+                float sratio = std::clamp(e.shield / st.shield_max, 0.0f, 1.0f);
                 int sw = (int)std::lround((double)w * (double)sratio);
                 int sh = 3;
                 SDL_Rect sb{bg.x, bg.y - (sh + 2), sw, sh};
@@ -276,8 +266,8 @@ void render() {
                 SDL_RenderFillRect(renderer, &sb);
             }
             // Plates as thin slivers aligned from right edge above the shield band
-            if (e.stats.plates > 0) {
-                int to_show = std::min(20, e.stats.plates);
+            if (st.plates > 0) {
+                int to_show = std::min(20, st.plates);
                 int slw = 3, gap = 1;
                 int slh = 4;
                 int py = bg.y - (slh + 6);
@@ -307,32 +297,29 @@ void render() {
             pb = pdraw->pos.y + ph.y;
         }
         // draw powerups
-        for (auto const& pu : ss->pickups.data())
-            if (pu.active) {
-                SDL_FPoint c = world_to_screen(pu.pos.x - 0.125f, pu.pos.y - 0.125f);
-                float scale = TILE_SIZE * gg->play_cam.zoom;
-                SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
-                           (int)std::ceil(0.25f * scale), (int)std::ceil(0.25f * scale)};
-                int sid = pu.sprite_id;
-                if (sid < 0 && luam) {
-                    for (auto const& pd : luam->powerups())
-                        if ((int)pd.type == (int)pu.type) {
-                            if (!pd.sprite.empty() && pd.sprite.find(':') != std::string::npos)
-                                sid = try_get_sprite_id(pd.sprite);
-                            break;
-                        }
-                }
-                if (sid >= 0) {
-                    if (SDL_Texture* tex = get_texture(sid))
-                        SDL_RenderCopy(renderer, tex, nullptr, &r);
-                    else
-                        add_warning("Missing texture for powerup sprite");
-                } else {
-                    add_warning("Missing sprite for powerup");
-                    SDL_SetRenderDrawColor(renderer, 100, 220, 120, 255);
-                    SDL_RenderFillRect(renderer, &r);
-                }
+        for (std::size_t slot : ss->pickups.active_slots()) {
+            auto const& pu = ss->pickups.data()[slot];
+            if (!cull.count(CULL_PICKUPS, view.overlaps(pu.pos, glm::vec2{0.125f})))
+                continue;
+            SDL_FPoint c = world_to_screen(pu.pos.x - 0.125f, pu.pos.y - 0.125f);
+            float scale = TILE_SIZE * gg->play_cam.zoom;
+            SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
+                       (int)std::ceil(0.25f * scale), (int)std::ceil(0.25f * scale)};
+            int sid = pu.sprite_id;
+            if (sid < 0 && luam) {
+                if (const PowerupDef* pd = luam->find_powerup((int)pu.type))
+                    sid = pd->sprite_id;
             }
+            if (sid >= 0) {
+                if (SpriteTex tex = get_sprite_tex(sid))
+                    batch_sprite(tex, r);
+                else
+                    add_warning("Missing texture for powerup sprite");
+            } else {
+                batch_fill(r, SDL_Color{100, 220, 120, 255});
+            }
+        }
+        flush_sprite_batch();
         // draw ground items and guns; highlight overlaps and prompt
         enum struct PK { None, Item, Gun };
         auto overlap_area = [&](float al, float at, float ar, float ab, float bl, float bt, float br, float bb) -> float {
@@ -348,9 +335,18 @@ void render() {
         };
         float best_area = 0.0f; PK best_kind = PK::None; std::size_t best_idx = (std::size_t)-1;
         // Ground items: draw and track best-overlap using index loop
-        for (std::size_t i = 0; i < ss->ground_items.data().size(); ++i) {
+        for (std::size_t i : ss->ground_items.active_slots()) {
             auto const& gi = ss->ground_items.data()[i];
-            if (!gi.active) continue;
+            // Overlap is tracked for culled items too; the prompt's inspect panel is screen-space
+            if (pdraw) {
+                glm::vec2 gh = gi.size * 0.5f;
+                float gl = gi.pos.x - gh.x, gr = gi.pos.x + gh.x;
+                float gt = gi.pos.y - gh.y, gb = gi.pos.y + gh.y;
+                float area_i = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
+                if (area_i > best_area) { best_area = area_i; best_kind = PK::Item; best_idx = i; }
+            }
+            if (!cull.count(CULL_GROUND_ITEMS, view.overlaps(gi.pos, gi.size * 0.5f)))
+                continue;
             SDL_FPoint c = world_to_screen(gi.pos.x - gi.size.x * 0.5f, gi.pos.y - gi.size.y * 0.5f);
             float scale = TILE_SIZE * gg->play_cam.zoom;
             SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
@@ -359,36 +355,30 @@ void render() {
             if (luam) {
                 const ItemInstance* inst = ss->items.get(gi.item_vid);
                 if (inst) {
-                    for (auto const& d : luam->items())
-                        if (d.type == inst->def_type) {
-                            if (!d.sprite.empty() && d.sprite.find(':') != std::string::npos)
-                                ispr = try_get_sprite_id(d.sprite);
-                            else
-                                ispr = -1;
-                            break;
-                        }
+                    if (const ItemDef* d = luam->find_item(inst->def_type)) {
+                        ispr = d->sprite_id;
+                    }
                 }
             }
             if (ispr >= 0) {
-                if (SDL_Texture* tex = get_texture(ispr))
-                    SDL_RenderCopy(renderer, tex, nullptr, &r);
+                if (SpriteTex tex = get_sprite_tex(ispr))
+                    batch_sprite(tex, r);
             } else {
-                add_warning("Missing sprite for item");
-                SDL_SetRenderDrawColor(renderer, 80, 220, 240, 255);
-                SDL_RenderFillRect(renderer, &r);
-            }
-            if (pdraw) {
-                glm::vec2 gh = gi.size * 0.5f;
-                float gl = gi.pos.x - gh.x, gr = gi.pos.x + gh.x;
-                float gt = gi.pos.y - gh.y, gb = gi.pos.y + gh.y;
-                float area_i = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
-                if (area_i > best_area) { best_area = area_i; best_kind = PK::Item; best_idx = i; }
+                batch_fill(r, SDL_Color{80, 220, 240, 255});
             }
         }
         // Ground guns
-        for (std::size_t i = 0; i < ss->ground_guns.data().size(); ++i) {
+        for (std::size_t i : ss->ground_guns.active_slots()) {
             auto const& ggun = ss->ground_guns.data()[i];
-            if (!ggun.active) continue;
+            if (pdraw) {
+                glm::vec2 gh = ggun.size * 0.5f;
+                float gl = ggun.pos.x - gh.x, gr = ggun.pos.x + gh.x;
+                float gt = ggun.pos.y - gh.y, gb = ggun.pos.y + gh.y;
+                float area_g = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
+                if (area_g > best_area) { best_area = area_g; best_kind = PK::Gun; best_idx = i; }
+            }
+            if (!cull.count(CULL_GROUND_GUNS, view.overlaps(ggun.pos, ggun.size * 0.5f)))
+                continue;
             SDL_FPoint c = world_to_screen(ggun.pos.x - ggun.size.x * 0.5f, ggun.pos.y - ggun.size.y * 0.5f);
             float scale = TILE_SIZE * gg->play_cam.zoom;
             SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
@@ -396,30 +386,21 @@ void render() {
             int sid = ggun.sprite_id;
             if (sid < 0 && luam) {
                 if (const GunInstance* gi = ss->guns.get(ggun.gun_vid)) {
-                    const GunDef* gd = nullptr;
-                    for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-                    if (gd && !gd->sprite.empty() && gd->sprite.find(':') != std::string::npos)
-                        sid = try_get_sprite_id(gd->sprite);
+                    const GunDef* gd = luam->find_gun(gi->def_type);
+                    if (gd)
+                        sid = gd->sprite_id;
                 }
             }
             if (sid >= 0) {
-                if (SDL_Texture* tex = get_texture(sid))
-                    SDL_RenderCopy(renderer, tex, nullptr, &r);
+                if (SpriteTex tex = get_sprite_tex(sid))
+                    batch_sprite(tex, r);
                 else
                     add_warning("Missing texture for gun sprite");
             } else {
-                add_warning("Missing sprite for gun");
-                SDL_SetRenderDrawColor(renderer, 220, 120, 220, 255);
-                SDL_RenderFillRect(renderer, &r);
-            }
-            if (pdraw) {
-                glm::vec2 gh = ggun.size * 0.5f;
-                float gl = ggun.pos.x - gh.x, gr = ggun.pos.x + gh.x;
-                float gt = ggun.pos.y - gh.y, gb = ggun.pos.y + gh.y;
-                float area_g = overlap_area(pl, pt, pr, pb, gl, gt, gr, gb);
-                if (area_g > best_area) { best_area = area_g; best_kind = PK::Gun; best_idx = i; }
+                batch_fill(r, SDL_Color{220, 120, 220, 255});
             }
         }
+        flush_sprite_batch();
         // Consolidated pickup prompt
         if (pdraw && gg->ui_font && ss->mode == ids::MODE_PLAYING && best_area > 0.0f) {
             std::string nm;
@@ -434,7 +415,7 @@ void render() {
                 if (luam) {
                     const ItemInstance* inst = ss->items.get(gi.item_vid);
                     if (inst) {
-                        for (auto const& d : luam->items()) if (d.type == inst->def_type) { nm = d.name; break; }
+                        if (const ItemDef* d = luam->find_item(inst->def_type)) nm = d->name;
                     }
                 }
             } else if (best_kind == PK::Gun) {
@@ -446,7 +427,7 @@ void render() {
                 nm = "gun";
                 if (luam) {
                     if (const GunInstance* gi = ss->guns.get(ggun.gun_vid)) {
-                        for (auto const& g : luam->guns()) if (g.type == gi->def_type) { nm = g.name; break; }
+                        if (const GunDef* g = luam->find_gun(gi->def_type)) nm = g->name;
                     }
                 }
             }
@@ -457,16 +438,8 @@ void render() {
             if (!keyname || !*keyname) keyname = "F";
             std::string prompt = std::string("Press ") + keyname + " to pick up " + nm;
             SDL_Color col{250, 250, 250, 255};
-            SDL_Surface* s = TTF_RenderUTF8_Blended(gg->ui_font, prompt.c_str(), col);
-            if (s) {
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                int tw = 0, th = 0;
-                SDL_QueryTexture(t, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{r.x, r.y - th - 2, tw, th};
-                SDL_RenderCopy(renderer, t, nullptr, &d);
-                SDL_DestroyTexture(t);
-                SDL_FreeSurface(s);
-            }
+            SDL_Point ps = measure_text(prompt);
+            draw_text(prompt, r.x, r.y - ps.y - 2, col);
 
             // Center inspect view for ground target when gun panel toggle (V) is on
             if (ss->show_gun_panel) {
@@ -487,24 +460,22 @@ void render() {
                     std::string iname = "item";
                     std::string idesc; bool consume = false; int sid = -1;
                     if (luam && inst) {
-                        for (auto const& ddf : luam->items()) if (ddf.type == inst->def_type) {
-                            iname = ddf.name; idesc = ddf.desc; consume = ddf.consume_on_use;
-                            if (!ddf.sprite.empty() && ddf.sprite.find(':') != std::string::npos)
-                                sid = try_get_sprite_id(ddf.sprite);
-                            break; }
+                        if (const ItemDef* ddf = luam->find_item(inst->def_type)) {
+                            iname = ddf->name; idesc = ddf->desc; consume = ddf->consume_on_use;
+                            sid = ddf->sprite_id;
+                        }
                     }
-                    if (sid >= 0) if (SDL_Texture* texi = get_texture(sid)) { SDL_Rect dst{tx, ty, 48, 32}; SDL_RenderCopy(renderer, texi, nullptr, &dst); ty += 36; }
+                    if (sid >= 0) if (SpriteTex texi = get_sprite_tex(sid)) { SDL_Rect dst{tx, ty, 48, 32}; SDL_RenderCopy(renderer, texi.tex, &texi.src, &dst); ty += 36; }
                     ui_draw_kv_line(tx, ty, lh, "Item", iname);
                     if (!idesc.empty()) ui_draw_kv_line(tx, ty, lh, "Desc", idesc);
                     ui_draw_kv_line(tx, ty, lh, "Consumable", consume ? std::string("Yes") : std::string("No"));
                 } else if (best_kind == PK::Gun) {
                     auto const& ggun = ss->ground_guns.data()[best_idx];
                     const GunInstance* gim = ss->guns.get(ggun.gun_vid);
-                    const GunDef* gdp = nullptr;
-                    if (luam && gim) { for (auto const& gdf : luam->guns()) if (gdf.type == gim->def_type) { gdp = &gdf; break; } }
+                    const GunDef* gdp = (luam && gim) ? luam->find_gun(gim->def_type) : nullptr;
                     if (gdp) {
-                        int gun_sid = -1; if (!gdp->sprite.empty()) gun_sid = try_get_sprite_id(gdp->sprite);
-                        if (gun_sid >= 0) if (SDL_Texture* texg = get_texture(gun_sid)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, texg, nullptr, &dst); ty += 44; }
+                        int gun_sid = gdp->sprite_id;
+                        if (gun_sid >= 0) if (SpriteTex texg = get_sprite_tex(gun_sid)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, texg.tex, &texg.src, &dst); ty += 44; }
                         ui_draw_kv_line(tx, ty, lh, "Gun", gdp->name);
                         ui_draw_kv_line(tx, ty, lh, "Damage", std::to_string((int)std::lround(gdp->damage)));
                         ui_draw_kv_line(tx, ty, lh, "RPM", std::to_string((int)std::lround(gdp->rpm)));
@@ -519,8 +490,8 @@ void render() {
                         ui_draw_kv_line(tx, ty, lh, "AR Size", fmt2(gdp->ar_size) + " ±" + fmt2(gdp->ar_size_variance));
                         if (gim && gim->ammo_type != 0) {
                             if (auto const* ad = luam->find_ammo(gim->ammo_type)) {
-                                int asid = (!ad->sprite.empty()) ? try_get_sprite_id(ad->sprite) : -1;
-                                if (asid >= 0) if (SDL_Texture* tex = get_texture(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 22; }
+                                int asid = ad->sprite_id;
+                                if (asid >= 0) if (SpriteTex tex = get_sprite_tex(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 22; }
                                 int apct = (int)std::lround(ad->armor_pen * 100.0f);
                                 ui_draw_kv_line(tx, ty, lh, "Ammo", ad->name);
                                 if (!ad->desc.empty()) ui_draw_kv_line(tx, ty, lh, "Desc", ad->desc);
@@ -542,28 +513,32 @@ void render() {
         }
     }
 
-    // draw projectiles (prefer sprite; fallback to red rect)
-    for (auto const& proj : ss->projectiles.items)
-        if (proj.active) {
-            SDL_FPoint c = world_to_screen(proj.pos.x - proj.size.x * 0.5f, proj.pos.y - proj.size.y * 0.5f);
-            float scale = TILE_SIZE * gg->play_cam.zoom;
-            SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
-                       (int)std::ceil(proj.size.x * scale), (int)std::ceil(proj.size.y * scale)};
-            bool drew = false;
-            if (proj.sprite_id >= 0) {
-                if (SDL_Texture* tex = get_texture(proj.sprite_id)) {
-                    SDL_RenderCopy(renderer, tex, nullptr, &r);
-                    drew = true;
-                } else {
-                    add_warning("Missing texture for projectile sprite");
-                }
-            }
-            if (!drew) {
-                add_warning("Missing sprite for projectile");
-                SDL_SetRenderDrawColor(renderer, 240, 80, 80, 255);
-                SDL_RenderFillRect(renderer, &r);
+    // draw projectiles (prefer sprite, turned to their heading; fallback to red rect)
+    for (std::size_t pi = 0; pi < ss->projectiles.size(); ++pi) {
+        glm::vec2 ppos = ss->projectiles.pos(pi), psize = ss->projectiles.size(pi);
+        // Half diagonal: covers the quad at any heading
+        if (!cull.count(CULL_PROJECTILES, view.overlaps(ppos, glm::vec2{glm::length(psize) * 0.5f})))
+            continue;
+        auto const& proj = ss->projectiles.info(pi);
+        SDL_FPoint c = world_to_screen(ppos.x - psize.x * 0.5f, ppos.y - psize.y * 0.5f);
+        float scale = TILE_SIZE * gg->play_cam.zoom;
+        SDL_Rect r{(int)std::floor(c.x), (int)std::floor(c.y),
+                   (int)std::ceil(psize.x * scale), (int)std::ceil(psize.y * scale)};
+        bool drew = false;
+        if (proj.sprite_id >= 0) {
+            if (SpriteTex tex = get_sprite_tex(proj.sprite_id)) {
+                glm::vec2 v = ss->projectiles.vel(pi);
+                float angle_deg = (v.x != 0.0f || v.y != 0.0f) ? std::atan2(v.y, v.x) * 180.0f / 3.14159265f : 0.0f;
+                batch_sprite(tex, r, angle_deg);
+                drew = true;
+            } else {
+                add_warning("Missing texture for projectile sprite");
             }
         }
+        if (!drew)
+            batch_fill(r, SDL_Color{240, 80, 80, 255});
+    }
+    flush_sprite_batch();
 
     // draw cursor crosshair + circle + reload/jam UI
     if (ss->mode == ids::MODE_PLAYING) {
@@ -586,14 +561,14 @@ void render() {
         float reticle_radius_px = 12.0f;
         if (ss->player_vid) {
             const Entity* plv = ss->entities.get(*ss->player_vid);
-            if (plv && plv->equipped_gun_vid.has_value() && luam) {
-                const GunInstance* gi = ss->guns.get(*plv->equipped_gun_vid);
-                const GunDef* gd = nullptr;
-                if (gi) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; } }
+            if (ss->entities.equipped_gun(plv) && luam) {
+                const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plv));
+                const GunDef* gd = gi ? luam->find_gun(gi->def_type) : nullptr;
                 if (gd) {
-                    float acc = std::max(0.1f, plv->stats.accuracy / 100.0f);
+                    auto const& pc = ss->entities.cold(*plv);
+                    float acc = std::max(0.1f, pc.stats.accuracy / 100.0f);
                     float base_dev = gd->deviation / acc;
-                    float move_spread = plv->move_spread_deg / acc;
+                    float move_spread = pc.move_spread_deg / acc;
                     float recoil_spread = gi->spread_recoil_deg;
                     float theta_deg = std::clamp(base_dev + move_spread + recoil_spread, MIN_SPREAD_DEG, MAX_SPREAD_DEG);
                     int ww = 0, wh = 0; SDL_GetRendererOutputSize(renderer, &ww, &wh);
@@ -622,10 +597,10 @@ void render() {
         // Vertical mag + reserve bars, active reload window, text, and unjam progress
         if (ss->player_vid) {
             const Entity* plv = ss->entities.get(*ss->player_vid);
-            if (plv && plv->equipped_gun_vid.has_value() && luam) {
-                const GunInstance* gi = ss->guns.get(*plv->equipped_gun_vid);
+            if (ss->entities.equipped_gun(plv) && luam) {
+                const GunInstance* gi = ss->guns.get(*ss->entities.equipped_gun(plv));
                 if (gi) {
-                    const GunDef* gd = nullptr; for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
+                    const GunDef* gd = luam->find_gun(gi->def_type);
                     if (gd) {
                         int bar_h = 60, bar_w = 8, gap = 2; int rx = mx + 16; int ry = my - bar_h / 2;
                         if (ss->reload_bar_shake > 0.01f) { static thread_local std::mt19937 rng{std::random_device{}()}; std::uniform_real_distribution<float> J(-ss->reload_bar_shake, ss->reload_bar_shake); rx += (int)std::lround(J(rng)); ry += (int)std::lround(J(rng)); ss->reload_bar_shake *= 0.90f; } else { ss->reload_bar_shake = 0.0f; }
@@ -662,7 +637,7 @@ void render() {
                             const char* txt = nullptr; SDL_Color col{250,220,80,255};
                             if (gi->jammed) { txt = "JAMMED!"; col = SDL_Color{240,80,80,255}; }
                             else if (gi->current_mag == 0) { txt = (gi->ammo_reserve > 0) ? "RELOAD" : "NO AMMO"; col = SDL_Color{250,220,80,255}; }
-                            if (txt) { if (SDL_Surface* s = TTF_RenderUTF8_Blended(gg->ui_font, txt, col)) { SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s); int tw=0,th=0; SDL_QueryTexture(t,nullptr,nullptr,&tw,&th); SDL_Rect d{rx - 4, ry - th - 4, tw, th}; SDL_RenderCopy(renderer, t, nullptr, &d); SDL_DestroyTexture(t); SDL_FreeSurface(s);} }
+                            if (txt) { SDL_Point ts = measure_text(txt); draw_text(txt, rx - 4, ry - ts.y - 4, col); }
                         }
                         if (gi->jammed) { SDL_Rect jb{rx - 12, ry, 4, bar_h}; SDL_SetRenderDrawColor(renderer, 50, 30, 30, 200); SDL_RenderFillRect(renderer, &jb); int jh = (int)std::lround((double)bar_h * (double)gi->unjam_progress); SDL_Rect jf{rx - 12, ry + (bar_h - jh), 4, jh}; SDL_SetRenderDrawColor(renderer, 240, 60, 60, 240); SDL_RenderFillRect(renderer, &jf); }
                     }
@@ -688,29 +663,30 @@ void render() {
             auto draw_line = [&](const char* key, float val, const char* suffix){
                 char buf[64]; std::snprintf(buf, sizeof(buf), "%s: %.2f%s", key, (double)val, suffix);
                 SDL_Color col{220,220,220,255};
-                if (SDL_Surface* srf = TTF_RenderUTF8_Blended(gg->ui_font, buf, col)) { SDL_Texture* t=SDL_CreateTextureFromSurface(renderer,srf); int tw=0,th=0; SDL_QueryTexture(t,nullptr,nullptr,&tw,&th); SDL_Rect d{tx,ty,tw,th}; SDL_RenderCopy(renderer,t,nullptr,&d); SDL_DestroyTexture(t); SDL_FreeSurface(srf);} ty += lh;
+                draw_text(buf, tx, ty, col); ty += lh;
             };
             const Entity* p = (ss->player_vid ? ss->entities.get(*ss->player_vid) : nullptr);
             if (p) {
-                draw_line("Health Max", p->stats.max_health, "");
-                draw_line("Health Regen", p->stats.health_regen, "/s");
-                draw_line("Shield Max", p->stats.shield_max, "");
-                draw_line("Shield Regen", p->stats.shield_regen, "/s");
-                draw_line("Armor", p->stats.armor, "%");
-                draw_line("Move Speed", p->stats.move_speed, "/s");
-                draw_line("Dodge", p->stats.dodge, "%");
-                draw_line("Scavenging", p->stats.scavenging, "");
-                draw_line("Currency", p->stats.currency, "");
-                draw_line("Ammo Gain", p->stats.ammo_gain, "");
-                draw_line("Luck", p->stats.luck, "");
-                draw_line("Crit Chance", p->stats.crit_chance, "%");
-                draw_line("Crit Damage", p->stats.crit_damage, "%");
-                draw_line("Headshot Damage", p->stats.headshot_damage, "%");
-                draw_line("Damage Absorb", p->stats.damage_absorb, "");
-                draw_line("Damage Output", p->stats.damage_output, "");
-                draw_line("Healing", p->stats.healing, "");
-                draw_line("Accuracy", p->stats.accuracy, "");
-                draw_line("Terror Level", p->stats.terror_level, "");
+                auto const& ps = ss->entities.cold(*p).stats;
+                draw_line("Health Max", ps.max_health, "");
+                draw_line("Health Regen", ps.health_regen, "/s");
+                draw_line("Shield Max", ps.shield_max, "");
+                draw_line("Shield Regen", ps.shield_regen, "/s");
+                draw_line("Armor", ps.armor, "%");
+                draw_line("Move Speed", ps.move_speed, "/s");
+                draw_line("Dodge", ps.dodge, "%");
+                draw_line("Scavenging", ps.scavenging, "");
+                draw_line("Currency", ps.currency, "");
+                draw_line("Ammo Gain", ps.ammo_gain, "");
+                draw_line("Luck", ps.luck, "");
+                draw_line("Crit Chance", ps.crit_chance, "%");
+                draw_line("Crit Damage", ps.crit_damage, "%");
+                draw_line("Headshot Damage", ps.headshot_damage, "%");
+                draw_line("Damage Absorb", ps.damage_absorb, "");
+                draw_line("Damage Output", ps.damage_output, "");
+                draw_line("Healing", ps.healing, "");
+                draw_line("Accuracy", ps.accuracy, "");
+                draw_line("Terror Level", ps.terror_level, "");
             }
         }
     }
@@ -735,12 +711,7 @@ void render() {
             char hk[4];
             std::snprintf(hk, sizeof(hk), "%d", (i == 9) ? 0 : (i + 1));
             SDL_Color hotc{150, 150, 150, 220};
-            if (SDL_Surface* hs = TTF_RenderUTF8_Blended(gg->ui_font, hk, hotc)) {
-                SDL_Texture* ht = SDL_CreateTextureFromSurface(renderer, hs);
-                int tw = 0, th = 0; SDL_QueryTexture(ht, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{slot.x - 20, slot.y + 2, tw, th}; SDL_RenderCopy(renderer, ht, nullptr, &d);
-                SDL_DestroyTexture(ht); SDL_FreeSurface(hs);
-            }
+            draw_text(hk, slot.x - 20, slot.y + 2, hotc);
             const InvEntry* ent = pinv ? pinv->get((std::size_t)i) : ss->inventory.get((std::size_t)i);
             if (ent) {
                 inv_hover_rects.push_back(HoverSlot{slot, (std::size_t)i});
@@ -749,9 +720,8 @@ void render() {
                 int label_x = slot.x + 8; int label_offset = 0;
                 auto draw_icon = [&](int sprite_id) {
                     if (sprite_id >= 0) {
-                        if (SDL_Texture* tex = get_texture(sprite_id)) {
-                            SDL_Rect dst{icon_x, icon_y, icon_w, icon_h};
-                            SDL_RenderCopy(renderer, tex, nullptr, &dst);
+                        if (SpriteTex tex = get_sprite_tex(sprite_id)) {
+                            batch_sprite(tex, SDL_Rect{icon_x, icon_y, icon_w, icon_h});
                             label_offset = icon_w + 10;
                         }
                     }
@@ -761,8 +731,8 @@ void render() {
                     if (const ItemInstance* inst = ss->items.get(ent->vid)) {
                         std::string nm = "item"; uint32_t count = inst->count; int sid = -1;
                         if (luam) {
-                            for (auto const& d : luam->items()) if (d.type == inst->def_type) {
-                                nm = d.name; if (!d.sprite.empty() && d.sprite.find(':') != std::string::npos) sid = try_get_sprite_id(d.sprite); break; }
+                            if (const ItemDef* d = luam->find_item(inst->def_type)) {
+                                nm = d->name; sid = d->sprite_id; }
                         }
                         draw_icon(sid); label = nm; if (count > 1) label += std::string(" x") + std::to_string(count);
                     }
@@ -770,31 +740,23 @@ void render() {
                     if (const GunInstance* gi = ss->guns.get(ent->vid)) {
                         std::string nm = "gun"; int sid = -1;
                         if (luam) {
-                            for (auto const& g : luam->guns()) if (g.type == gi->def_type) { nm = g.name; if (!g.sprite.empty() && g.sprite.find(':') != std::string::npos) sid = try_get_sprite_id(g.sprite); break; }
+                            if (const GunDef* g = luam->find_gun(gi->def_type)) { nm = g->name; sid = g->sprite_id; }
                         }
                         draw_icon(sid); label = nm;
                     }
                 }
                 if (!label.empty()) {
                     SDL_Color tc{230, 230, 230, 255};
-                    if (SDL_Surface* ts = TTF_RenderUTF8_Blended(gg->ui_font, label.c_str(), tc)) {
-                        SDL_Texture* tt = SDL_CreateTextureFromSurface(renderer, ts);
-                        int tw = 0, th = 0; SDL_QueryTexture(tt, nullptr, nullptr, &tw, &th);
-                        SDL_Rect d{label_x + label_offset, slot.y + 2, tw, th}; SDL_RenderCopy(renderer, tt, nullptr, &d);
-                        SDL_DestroyTexture(tt); SDL_FreeSurface(ts);
-                    }
+                    draw_text(label, label_x + label_offset, slot.y + 2, tc);
                 }
             }
         }
+        flush_sprite_batch(); // icons; they overlap nothing else in the list
         // Drop mode hint
         if (ss->drop_mode) {
             SDL_Color hintc{230, 220, 80, 255}; const char* hint = "Drop mode: press 1–0";
-            if (SDL_Surface* hs = TTF_RenderUTF8_Blended(gg->ui_font, hint, hintc)) {
-                SDL_Texture* ht = SDL_CreateTextureFromSurface(renderer, hs);
-                int tw = 0, th = 0; SDL_QueryTexture(ht, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{sx, sy - th - 8, tw, th}; SDL_RenderCopy(renderer, ht, nullptr, &d);
-                SDL_DestroyTexture(ht); SDL_FreeSurface(hs);
-            }
+            SDL_Point hs = measure_text(hint);
+            draw_text(hint, sx, sy - hs.y - 8, hintc);
         }
         // Hover handling + center panel
         SDL_Point mp{ss->mouse_inputs.pos.x, ss->mouse_inputs.pos.y};
@@ -835,14 +797,12 @@ void render() {
                 SDL_SetRenderDrawColor(renderer, 25, 25, 30, 220); SDL_RenderFillRect(renderer, &box);
                 SDL_SetRenderDrawColor(renderer, 200, 200, 220, 255); SDL_RenderDrawRect(renderer, &box);
                 int tx = px + 12; int ty = py + 12; int lh = 18;
-                auto draw_txt = [&](const std::string& s, SDL_Color col) {
-                    SDL_Surface* srf = TTF_RenderUTF8_Blended(gg->ui_font, s.c_str(), col);
-                    if (srf) { SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, srf); int tw=0,th=0; SDL_QueryTexture(t,nullptr,nullptr,&tw,&th); SDL_Rect d{tx, ty, tw, th}; SDL_RenderCopy(renderer, t, nullptr, &d); SDL_DestroyTexture(t); SDL_FreeSurface(srf);} ty += lh; };
+                auto draw_txt = [&](const std::string& s, SDL_Color col) { draw_text(s, tx, ty, col); ty += lh; };
                 if (sel->kind == INV_ITEM) {
                     if (const ItemInstance* inst = ss->items.get(sel->vid)) {
                         std::string nm = "item"; std::string desc; uint32_t maxc = 1; bool consume = false; int sid = -1;
-                        if (luam) { for (auto const& d : luam->items()) if (d.type == inst->def_type) { nm=d.name; desc=d.desc; maxc=(uint32_t)d.max_count; consume=d.consume_on_use; if(!d.sprite.empty() && d.sprite.find(':')!=std::string::npos) sid=try_get_sprite_id(d.sprite); break; } }
-                        if (sid >= 0) if (SDL_Texture* tex = get_texture(sid)) { SDL_Rect dst{tx, ty, 48, 32}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 36; }
+                        if (luam) { if (const ItemDef* d = luam->find_item(inst->def_type)) { nm=d->name; desc=d->desc; maxc=(uint32_t)d->max_count; consume=d->consume_on_use; sid=d->sprite_id; } }
+                        if (sid >= 0) if (SpriteTex tex = get_sprite_tex(sid)) { SDL_Rect dst{tx, ty, 48, 32}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 36; }
                         draw_txt(std::string("Item: ") + nm, SDL_Color{255,255,255,255});
                         draw_txt(std::string("Count: ") + std::to_string(inst->count) + "/" + std::to_string(maxc), SDL_Color{220,220,220,255});
                         if (!desc.empty()) draw_txt(std::string("Desc: ") + desc, SDL_Color{200,200,200,255});
@@ -850,11 +810,10 @@ void render() {
                     }
                 } else if (sel->kind == INV_GUN) {
                     if (const GunInstance* gi = ss->guns.get(sel->vid)) {
-                        std::string nm = "gun"; const GunDef* gdp = nullptr;
-                        if (luam) { for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gdp = &g; break; } }
+                        std::string nm = "gun"; const GunDef* gdp = luam ? luam->find_gun(gi->def_type) : nullptr;
                         if (gdp) {
-                            int gun_sid = -1; if (!gdp->sprite.empty()) gun_sid = try_get_sprite_id(gdp->sprite);
-                            if (gun_sid >= 0) if (SDL_Texture* tex = get_texture(gun_sid)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 44; }
+                            int gun_sid = gdp->sprite_id;
+                            if (gun_sid >= 0) if (SpriteTex tex = get_sprite_tex(gun_sid)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 44; }
                             draw_txt(std::string("Gun: ") + gdp->name, SDL_Color{255,255,255,255});
                             draw_txt(std::string("Damage: ") + std::to_string((int)std::lround(gdp->damage)), SDL_Color{220,220,220,255});
                             draw_txt(std::string("RPM: ") + std::to_string((int)std::lround(gdp->rpm)), SDL_Color{220,220,220,255});
@@ -867,8 +826,8 @@ void render() {
                             draw_txt(std::string("Jam: ") + std::to_string((int)std::lround(gdp->jam_chance * 100.0f)) + " %", SDL_Color{220,220,220,255});
                             if (gi->ammo_type != 0) {
                                 if (auto const* ad = luam->find_ammo(gi->ammo_type)) {
-                                    int asid = (!ad->sprite.empty()) ? try_get_sprite_id(ad->sprite) : -1;
-                                    if (asid >= 0) if (SDL_Texture* tex = get_texture(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 22; }
+                                    int asid = ad->sprite_id;
+                                    if (asid >= 0) if (SpriteTex tex = get_sprite_tex(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 22; }
                                     draw_txt(std::string("Ammo: ") + ad->name, SDL_Color{255,255,255,255});
                                     if (!ad->desc.empty()) draw_txt(std::string("Desc: ") + ad->desc, SDL_Color{200,200,200,255});
                                     int apct = (int)std::lround(ad->armor_pen * 100.0f);
@@ -889,9 +848,9 @@ void render() {
     // Right-side equipped gun info panel (toggle with V)
     if (gg->ui_font && ss->mode == ids::MODE_PLAYING && ss->player_vid && luam && ss->show_gun_panel) {
         const Entity* ply = ss->entities.get(*ss->player_vid);
-        if (ply && ply->equipped_gun_vid.has_value()) {
-            const GunDef* gd = nullptr; const GunInstance* gi_inst = ss->guns.get(*ply->equipped_gun_vid);
-            if (gi_inst) { for (auto const& g : luam->guns()) if (g.type == gi_inst->def_type) { gd = &g; break; } }
+        if (ss->entities.equipped_gun(ply)) {
+            const GunInstance* gi_inst = ss->guns.get(*ss->entities.equipped_gun(ply));
+            const GunDef* gd = gi_inst ? luam->find_gun(gi_inst->def_type) : nullptr;
             if (gd) {
                 int panel_w = (int)std::lround(width * 0.26);
                 int px = width - panel_w - 30; int py = (int)std::lround(height * 0.18);
@@ -899,9 +858,9 @@ void render() {
                 SDL_SetRenderDrawColor(renderer, 25, 25, 30, 220); SDL_RenderFillRect(renderer, &box);
                 SDL_SetRenderDrawColor(renderer, 200, 200, 220, 255); SDL_RenderDrawRect(renderer, &box);
                 int tx = px + 12; int ty = py + 12; int lh = 18;
-                auto draw_txt = [&](const std::string& s, SDL_Color col){ SDL_Surface* srf = TTF_RenderUTF8_Blended(gg->ui_font, s.c_str(), col); if (srf){ SDL_Texture* t=SDL_CreateTextureFromSurface(renderer,srf); int tw=0,th=0; SDL_QueryTexture(t,nullptr,nullptr,&tw,&th); SDL_Rect d{tx,ty,tw,th}; SDL_RenderCopy(renderer,t,nullptr,&d); SDL_DestroyTexture(t); SDL_FreeSurface(srf);} ty += lh; };
+                auto draw_txt = [&](const std::string& s, SDL_Color col){ draw_text(s, tx, ty, col); ty += lh; };
                 // Icon
-                if (!gd->sprite.empty()) { int sid = try_get_sprite_id(gd->sprite); if (sid >= 0) if (SDL_Texture* tex = get_texture(sid)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 44; } }
+                if (gd->sprite_id >= 0) { if (SpriteTex tex = get_sprite_tex(gd->sprite_id)) { SDL_Rect dst{tx, ty, 64, 40}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 44; } }
                 // Key stats
                 ui_draw_kv_line(tx, ty, lh, "Gun", gd->name);
                 ui_draw_kv_line(tx, ty, lh, "Damage", std::to_string((int)std::lround(gd->damage)));
@@ -924,8 +883,8 @@ void render() {
                     ui_draw_kv_line(tx, ty, lh, "Reserve", std::to_string(gi_inst->ammo_reserve));
                     if (gi_inst->ammo_type != 0) {
                         if (auto const* ad = luam->find_ammo(gi_inst->ammo_type)) {
-                            int asid = (!ad->sprite.empty()) ? try_get_sprite_id(ad->sprite) : -1;
-                            if (asid >= 0) if (SDL_Texture* tex = get_texture(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex, nullptr, &dst); ty += 22; }
+                            int asid = ad->sprite_id;
+                            if (asid >= 0) if (SpriteTex tex = get_sprite_tex(asid)) { SDL_Rect dst{tx, ty, 36, 20}; SDL_RenderCopy(renderer, tex.tex, &tex.src, &dst); ty += 22; }
                             int apct = (int)std::lround(ad->armor_pen * 100.0f);
                             ui_draw_kv_line(tx, ty, lh, "Ammo", ad->name);
                             if (!ad->desc.empty()) ui_draw_kv_line(tx, ty, lh, "Desc", ad->desc);
@@ -951,6 +910,7 @@ void render() {
     if (gg->ui_font && ss->mode == ids::MODE_PLAYING && ss->player_vid) {
         const Entity* p = ss->entities.get(*ss->player_vid);
         if (p) {
+            auto const& ps = ss->entities.cold(*p).stats;
             int group_w = std::max(200, (int)std::lround(width * 0.25));
             int bar_h = 16;
             int gap_y = 6;
@@ -967,12 +927,9 @@ void render() {
                 ss->hp_bar_shake = 0.0f;
             }
             auto draw_num = [&](const std::string& s, int x, int y, SDL_Color col) {
-                SDL_Surface* srf = TTF_RenderUTF8_Blended(gg->ui_font, s.c_str(), col);
-                if (!srf) return SDL_Point{x, y};
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, srf);
-                int tw = 0, th = 0; SDL_QueryTexture(t, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{x, y + (bar_h - th) / 2, tw, th}; SDL_RenderCopy(renderer, t, nullptr, &d);
-                SDL_DestroyTexture(t); SDL_FreeSurface(srf);
+                SDL_Point ts = measure_text(s);
+                if (ts.x == 0) return SDL_Point{x, y};
+                SDL_Rect d = draw_text(s, x, y + (bar_h - ts.y) / 2, col);
                 return SDL_Point{d.x + d.w, d.y + d.h};
             };
             auto draw_bar = [&](int x, int y, int w, int h, float ratio, SDL_Color fill) {
@@ -984,17 +941,17 @@ void render() {
             };
             SDL_Color white{240, 240, 240, 255};
             // Shield
-            if (p->stats.shield_max > 0.0f) {
-                float sratio = (p->stats.shield_max > 0.0f) ? (p->shield / p->stats.shield_max) : 0.0f;
+            if (ps.shield_max > 0.0f) {
+                float sratio = (ps.shield_max > 0.0f) ? (p->shield / ps.shield_max) : 0.0f;
                 draw_bar(gx, gy, group_w, bar_h, sratio, SDL_Color{120, 200, 240, 220});
                 draw_num(std::to_string((int)std::lround(p->shield)), gx - 46, gy, white);
-                draw_num(std::to_string((int)std::lround(p->stats.shield_max)), gx + group_w + 6, gy, white);
+                draw_num(std::to_string((int)std::lround(ps.shield_max)), gx + group_w + 6, gy, white);
             }
             // Plates
             int gy2 = gy + bar_h + gap_y;
             draw_bar(gx, gy2, group_w, bar_h, 0.0f, SDL_Color{0, 0, 0, 0});
             {
-                int to_show = std::min(20, p->stats.plates);
+                int to_show = std::min(20, ps.plates);
                 int slw = 6, gap = 2;
                 int start_x = gx;
                 for (int i = 0; i < to_show; ++i) {
@@ -1002,7 +959,7 @@ void render() {
                     SDL_SetRenderDrawColor(renderer, 80, 80, 80, 255); SDL_RenderFillRect(renderer, &prr);
                     SDL_SetRenderDrawColor(renderer, 140, 140, 140, 255); SDL_RenderDrawRect(renderer, &prr);
                 }
-                draw_num(std::to_string(p->stats.plates), gx - 46, gy2, white);
+                draw_num(std::to_string(ps.plates), gx - 46, gy2, white);
             }
             // Health
             int gy3 = gy2 + bar_h + gap_y;
@@ -1053,13 +1010,12 @@ void render() {
         if (gg->ui_font) {
             const char* label = "Exiting to next area";
             SDL_Color lc{240, 220, 80, 255};
-            if (SDL_Surface* lsurf = TTF_RenderUTF8_Blended(gg->ui_font, label, lc)) {
-                SDL_Texture* ltex = SDL_CreateTextureFromSurface(renderer, lsurf);
-                if (ltex) { int lw=0,lh=0; SDL_QueryTexture(ltex,nullptr,nullptr,&lw,&lh); SDL_Rect ldst{bar_x, bar_y - lh - 6, lw, lh}; SDL_RenderCopy(renderer, ltex, nullptr, &ldst); SDL_DestroyTexture(ltex);} SDL_FreeSurface(lsurf);
-            }
+            SDL_Point ls = measure_text(label);
+            draw_text(label, bar_x, bar_y - ls.y - 6, lc);
             char txt[16]; float secs = std::max(0.0f, ss->exit_countdown); std::snprintf(txt, sizeof(txt), "%.1f", (double)secs);
             SDL_Color color{255, 255, 255, 255};
-            if (SDL_Surface* surf = TTF_RenderUTF8_Blended(gg->ui_font, txt, color)) { SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf); if (tex) { int tw=0,th=0; SDL_QueryTexture(tex,nullptr,nullptr,&tw,&th); SDL_Rect dst{bar_x + bar_w / 2 - tw / 2, bar_y - th - 4, tw, th}; SDL_RenderCopy(renderer, tex, nullptr, &dst); SDL_DestroyTexture(tex);} SDL_FreeSurface(surf); }
+            SDL_Point ts = measure_text(txt);
+            draw_text(txt, bar_x + bar_w / 2 - ts.x / 2, bar_y - ts.y - 4, color);
         }
     }
 
@@ -1070,33 +1026,14 @@ void render() {
         int ax = 12, ay = 12, lh = 18;
         // Alerts in white-ish
         for (const auto& al : ss->alerts) {
-            std::string msg = al.text;
             SDL_Color col{230, 230, 240, 255};
-            SDL_Surface* s = TTF_RenderUTF8_Blended(gg->ui_font, msg.c_str(), col);
-            if (s) {
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                int tw = 0, th = 0;
-                SDL_QueryTexture(t, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{ax, ay, tw, th};
-                SDL_RenderCopy(renderer, t, nullptr, &d);
-                SDL_DestroyTexture(t);
-                SDL_FreeSurface(s);
-            }
+            draw_text(al.text, ax, ay, col);
             ay += lh;
         }
         // Warnings in red
         for (const auto& msg : frame_warnings) {
             SDL_Color col2{220, 60, 60, 255};
-            SDL_Surface* s = TTF_RenderUTF8_Blended(gg->ui_font, msg.c_str(), col2);
-            if (s) {
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                int tw = 0, th = 0;
-                SDL_QueryTexture(t, nullptr, nullptr, &tw, &th);
-                SDL_Rect d{ax, ay, tw, th};
-                SDL_RenderCopy(renderer, t, nullptr, &d);
-                SDL_DestroyTexture(t);
-                SDL_FreeSurface(s);
-            }
+            draw_text(msg, ax, ay, col2);
             ay += lh;
         }
     }
@@ -1108,21 +1045,12 @@ void render() {
         SDL_RenderFillRect(renderer, &full);
         if (gg->ui_font) {
             SDL_Color titlec{240, 220, 80, 255};
-            if (SDL_Surface* ts = TTF_RenderUTF8_Blended(gg->ui_font, "Stage Clear", titlec)) {
-                SDL_Texture* tt = SDL_CreateTextureFromSurface(renderer, ts);
-                int tw=0, th=0; SDL_QueryTexture(tt, nullptr, nullptr, &tw, &th);
-                SDL_Rect td{40, 40, tw, th}; SDL_RenderCopy(renderer, tt, nullptr, &td);
-                SDL_DestroyTexture(tt); SDL_FreeSurface(ts);
-            }
+            draw_text("Stage Clear", 40, 40, titlec);
             if (ss->score_ready_timer <= 0.0f) {
                 SDL_Color pc{200, 200, 210, 255};
-                if (SDL_Surface* ps = TTF_RenderUTF8_Blended(gg->ui_font, "Press SPACE or CLICK to continue", pc)) {
-                    SDL_Texture* ptex = SDL_CreateTextureFromSurface(renderer, ps);
-                    int prompt_w=0, prompt_h=0; SDL_QueryTexture(ptex, nullptr, nullptr, &prompt_w, &prompt_h);
-                    SDL_Rect pd{width/2 - prompt_w/2, height - prompt_h - 20, prompt_w, prompt_h};
-                    SDL_RenderCopy(renderer, ptex, nullptr, &pd);
-                    SDL_DestroyTexture(ptex); SDL_FreeSurface(ps);
-                }
+                const char* prompt = "Press SPACE or CLICK to continue";
+                SDL_Point ps = measure_text(prompt);
+                draw_text(prompt, width/2 - ps.x/2, height - ps.y - 20, pc);
             }
         }
         if (ss->score_ready_timer <= 0.0f) {
@@ -1130,7 +1058,7 @@ void render() {
             if (ss->review_next_stat_timer <= 0.0f && ss->review_revealed < ss->review_stats.size()) {
                 ss->review_next_stat_timer = 0.2f;
                 ss->review_revealed += 1;
-                if (aa) play_sound("base:small_shoot");
+                if (aa) play_sound("base:small_shoot"_sym);
             }
             ss->review_number_tick_timer += (float)dt;
             while (ss->review_number_tick_timer >= 0.05f) {
@@ -1141,14 +1069,14 @@ void render() {
                     double step = std::max(1.0, std::floor(rs.target / 20.0));
                     if (rs.target < 20.0) step = std::max(0.1, rs.target / 20.0);
                     rs.value = std::min(rs.target, rs.value + step);
-                    if (aa) play_sound("base:small_shoot");
+                    if (aa) play_sound("base:small_shoot"_sym);
                     if (rs.value >= rs.target) rs.done = true;
                 }
             }
         }
         if (gg->ui_font) {
             int tx = 40; int ty = 80;
-            auto draw_line = [&](const std::string& s, SDL_Color col){ SDL_Surface* srf = TTF_RenderUTF8_Blended(gg->ui_font, s.c_str(), col); if (!srf) return; SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, srf); int tw=0, th=0; SDL_QueryTexture(tex, nullptr, nullptr, &tw, &th); SDL_Rect d{tx, ty, tw, th}; SDL_RenderCopy(renderer, tex, nullptr, &d); SDL_DestroyTexture(tex); SDL_FreeSurface(srf); ty += 18; };
+            auto draw_line = [&](const std::string& s, SDL_Color col){ if (s.empty()) return; draw_text(s, tx, ty, col); ty += 18; };
             SDL_Color mc{210, 210, 220, 255}; char buf[128];
             for (std::size_t i = 0; i < ss->review_revealed && i < ss->review_stats.size(); ++i) {
                 auto const& rs = ss->review_stats[i];
@@ -1181,10 +1109,25 @@ void render() {
         SDL_SetRenderDrawColor(renderer, 200, 200, 220, 255); SDL_RenderDrawRect(renderer, &box);
         SDL_SetRenderDrawColor(renderer, 240, 220, 80, 255); SDL_RenderDrawLine(renderer, box_x + 20, box_y + 20, box_x + box_w - 20, box_y + 20);
         if (gg->ui_font) {
-            SDL_Color titlec{240, 220, 80, 255}; if (SDL_Surface* ts = TTF_RenderUTF8_Blended(gg->ui_font, "Next Area", titlec)) { SDL_Texture* tt = SDL_CreateTextureFromSurface(renderer, ts); int tw=0, th=0; SDL_QueryTexture(tt,nullptr,nullptr,&tw,&th); SDL_Rect td{box_x + 24, box_y + 16, tw, th}; SDL_RenderCopy(renderer, tt, nullptr, &td); SDL_DestroyTexture(tt); SDL_FreeSurface(ts); }
-            if (ss->score_ready_timer <= 0.0f) { SDL_Color pc{200, 200, 210, 255}; if (SDL_Surface* ps = TTF_RenderUTF8_Blended(gg->ui_font, "Press SPACE or CLICK to continue", pc)) { SDL_Texture* ptex = SDL_CreateTextureFromSurface(renderer, ps); int prompt_w=0,prompt_h=0; SDL_QueryTexture(ptex,nullptr,nullptr,&prompt_w,&prompt_h); SDL_Rect pd{width/2 - prompt_w/2, height - prompt_h - 20, prompt_w, prompt_h}; SDL_RenderCopy(renderer, ptex, nullptr, &pd); SDL_DestroyTexture(ptex); SDL_FreeSurface(ps);} }
+            SDL_Color titlec{240, 220, 80, 255}; draw_text("Next Area", box_x + 24, box_y + 16, titlec);
+            if (ss->score_ready_timer <= 0.0f) { SDL_Color pc{200, 200, 210, 255}; const char* prompt = "Press SPACE or CLICK to continue"; SDL_Point ps = measure_text(prompt); draw_text(prompt, width/2 - ps.x/2, height - ps.y - 20, pc); }
         }
     }
 
+    text_end_frame();
+    atlas_end_frame(gg->atlas);
+    cull.end_frame();
     SDL_RenderPresent(renderer);
 }
+
+void log_cull_stats() {
+    if (!gg || gg->cull.frames == 0) return;
+    const CullStats& c = gg->cull;
+    const double n = static_cast<double>(c.frames);
+    std::printf("[gfx] culling over %llu frames (avg per frame):\n", static_cast<unsigned long long>(c.frames));
+    for (std::size_t i = 0; i < CULL_PASSES; ++i) {
+        if (c.total_drawn[i] == 0 && c.total_culled[i] == 0) continue;
+        std::printf("[gfx]   %-14s %10.1f drawn %10.1f culled\n", CULL_PASS_NAMES[i],
+                    static_cast<double>(c.total_drawn[i]) / n, static_cast<double>(c.total_culled[i]) / n);
+    }
+}
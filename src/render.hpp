@@ -9,3 +9,6 @@
 // Renders a full frame, including world and UI. Safe to call with null renderer
 // (falls back to a short sleep to avoid busy-wait). Uses gfx.renderer.
 void render();
+
+// Print per-pass drawn/culled counts averaged over the frames rendered.
+void log_cull_stats();
@@ -3,20 +3,23 @@
 
 #include "globals.hpp"
 #include "luamgr.hpp"
+#include "scripting_ticks.hpp"
 #include "sprites.hpp"
 
 #include <SDL2/SDL.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <random>
 
 void generate_room() {
     // Reset world
     ss->gun_cooldown = 0.0f;
-    ss->projectiles = Projectiles{};
-    ss->entities = Entities{};
+    ss->projectiles.clear();
+    ss->entities.reset();
     ss->player_vid.reset();
+    ss->tick_hosts.clear();
     ss->start_tile = {-1, -1};
     ss->exit_tile = {-1, -1};
     ss->exit_countdown = -1.0f;
@@ -66,12 +69,12 @@ void generate_room() {
     if (start_idx < 0) {
         start_idx = 0;
         auto c = corners[static_cast<size_t>(0)];
-        ss->stage.at(c.x, c.y) = TileProps::Make(false, false);
+        ss->stage.set(c.x, c.y, TileProps::Make(false, false));
     }
     if (exit_idx < 0 || exit_idx == start_idx) {
         exit_idx = (start_idx + 3) % 4;
         auto c = corners[static_cast<size_t>(exit_idx)];
-        ss->stage.at(c.x, c.y) = TileProps::Make(false, false);
+        ss->stage.set(c.x, c.y, TileProps::Make(false, false));
     }
 
     ss->start_tile = corners[static_cast<size_t>(start_idx)];
@@ -86,11 +89,13 @@ void generate_room() {
         }
         int t = type(rng);
         if (t <= 1) {
-            ss->stage.at(x, y) = TileProps::Make(true, false); // void/water: blocks entities only
+            ss->stage.set(x, y, TileProps::Make(true, false)); // void/water: blocks entities only
         } else {
-            ss->stage.at(x, y) = TileProps::Make(true, true); // wall: blocks both
+            ss->stage.set(x, y, TileProps::Make(true, true)); // wall: blocks both
         }
     }
+    // Same-size stages reuse the cached tile chunks; start/exit moved too
+    ss->rebuild_render_texture = true;
 
     // Create player at start
     if (auto pvid = ss->entities.new_entity()) {
@@ -100,10 +105,10 @@ void generate_room() {
         p->sprite_size = {0.25f, 0.25f};
         p->pos = {static_cast<float>(ss->start_tile.x) + 0.5f,
                   static_cast<float>(ss->start_tile.y) + 0.5f};
-        p->sprite_id = try_get_sprite_id("base:player");
+        p->sprite_id = try_get_sprite_id("base:player"_sym);
         p->max_hp = 1000;
         p->health = p->max_hp;
-        p->shield = p->stats.shield_max;
+        p->shield = ss->entities.cold(*p).stats.shield_max;
         ss->player_vid = pvid;
     }
 
@@ -134,10 +139,7 @@ void generate_room() {
             auto* p = ss->pickups.spawn(static_cast<uint32_t>(pu.type), pu.name,
                                           place({1.0f, 0.0f}));
             if (p) {
-                if (!pu.sprite.empty() && pu.sprite.find(':') != std::string::npos)
-                    p->sprite_id = try_get_sprite_id(pu.sprite);
-                else
-                    p->sprite_id = -1;
+                p->sprite_id = pu.sprite_id;
             }
         }
         if (luam && luam->powerups().size() > 1) {
@@ -145,28 +147,21 @@ void generate_room() {
             auto* p = ss->pickups.spawn(static_cast<uint32_t>(pu.type), pu.name,
                                           place({0.0f, 1.0f}));
             if (p) {
-                if (!pu.sprite.empty() && pu.sprite.find(':') != std::string::npos)
-                    p->sprite_id = try_get_sprite_id(pu.sprite);
-                else
-                    p->sprite_id = -1;
+                p->sprite_id = pu.sprite_id;
             }
         }
         // Place example guns near spawn: pistol and rifle if present in Lua
         if (luam && !luam->guns().empty()) {
             auto gd = luam->guns()[0];
             auto gv = ss->guns.spawn_from_def(gd);
-            int sid = -1;
-            if (!gd.sprite.empty() && gd.sprite.find(':') != std::string::npos)
-                sid = try_get_sprite_id(gd.sprite);
+            int sid = gd.sprite_id;
             if (gv)
                 ss->ground_guns.spawn(*gv, place({2.0f, 0.0f}), sid);
         }
         if (luam && luam->guns().size() > 1) {
             auto gd = luam->guns()[1];
             auto gv = ss->guns.spawn_from_def(gd);
-            int sid = -1;
-            if (!gd.sprite.empty() && gd.sprite.find(':') != std::string::npos)
-                sid = try_get_sprite_id(gd.sprite);
+            int sid = gd.sprite_id;
             if (gv)
                 ss->ground_guns.spawn(*gv, place({0.0f, 2.0f}), sid);
         }
@@ -174,12 +169,10 @@ void generate_room() {
         if (luam && ss->player_vid) {
             Entity* p = ss->entities.get_mut(*ss->player_vid);
             auto add_gun_to_inv = [&](int gun_type) {
-                for (auto const& g : luam->guns()) {
-                    if (g.type == gun_type) {
-                        if (auto gv = ss->guns.spawn_from_def(g)) {
-                            if (ss->player_vid) if (auto* inv = ss->inv_for(*ss->player_vid)) inv->insert_existing(INV_GUN, *gv);
-                            return *gv;
-                        }
+                if (const GunDef* g = luam->find_gun(gun_type)) {
+                    if (auto gv = ss->guns.spawn_from_def(*g)) {
+                        if (ss->player_vid) if (auto* inv = ss->inv_for(*ss->player_vid)) inv->insert_existing(INV_GUN, *gv);
+                        return *gv;
                     }
                 }
                 return VID{};
@@ -190,11 +183,17 @@ void generate_room() {
             v3 = add_gun_to_inv(212);
             if (v1.id || v2.id || v3.id) {
                 // Equip the pump if available
-                if (v1.id) p->equipped_gun_vid = v1;
-                else if (v2.id) p->equipped_gun_vid = v2;
-                else if (v3.id) p->equipped_gun_vid = v3;
+                auto& equipped = ss->entities.cold(*p).equipped_gun_vid;
+                if (v1.id) equipped = v1;
+                else if (v2.id) equipped = v2;
+                else if (v3.id) equipped = v3;
             }
         }
+        // The player is a new VID but keeps its inventory (indexed by slot),
+        // so every carried gun/item needs a host owned by the new VID
+        tick_rebuild_hosts();
+        if (std::size_t missing = tick_missing_inv_hosts())
+            std::fprintf(stderr, "[lua] %zu inventory tick hosts missing after room change\n", missing);
         // Let Lua generate room content (crates, loot, etc.) if function is present
         if (luam)
             luam->call_generate_room();
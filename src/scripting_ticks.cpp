@@ -1,136 +1,212 @@
 // Lua scripting tick execution (pre/post physics).
+#include "scripting_ticks.hpp"
 #include "globals.hpp"
 #include "luamgr.hpp"
+#include "lua/lua_helpers.hpp"
+#include "lua/watchdog.hpp"
 
 #include <algorithm>
-#include <string>
+#include <optional>
+#include <utility>
+#include <vector>
 
-void pre_physics_ticks() {
-    if (ss->player_vid && luam) {
-        Entity* plbt = ss->entities.get_mut(*ss->player_vid);
-        if (plbt) {
-            const float dt = TIMESTEP;
-            const int MAX_TICKS = 4000;
-            int tick_calls = 0;
-            // Guns with on_step (before phase)
-            const Inventory* pinv = (ss->player_vid ? ss->inv_for(*ss->player_vid) : nullptr);
-            if (pinv)
-            for (const auto& entry : pinv->entries) {
-                if (entry.kind != INV_GUN) continue;
-                GunInstance* gi = ss->guns.get(entry.vid);
-                if (!gi) continue;
-                const GunDef* gd = nullptr;
-                for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-                if (!gd || !luam->has_gun_on_step(gd->type)) continue;
-                if (gd->tick_rate_hz <= 0.0f || gd->tick_phase == std::string("after")) continue;
-                gi->tick_acc += dt;
-                float period = 1.0f / std::max(1.0f, gd->tick_rate_hz);
-                while (gi->tick_acc >= period && tick_calls < MAX_TICKS) {
-                    luam->call_gun_on_step(gi->def_type, *plbt);
-                    gi->tick_acc -= period;
-                    ++tick_calls;
-                }
-            }
-            // Items with on_tick (before phase)
-            if (pinv)
-            for (const auto& entry : pinv->entries) {
-                if (entry.kind != INV_ITEM) continue;
-                ItemInstance* inst = ss->items.get(entry.vid);
-                if (!inst) continue;
-                const ItemDef* idf = nullptr;
-                for (auto const& d : luam->items()) if (d.type == inst->def_type) { idf = &d; break; }
-                if (!idf || !luam->has_item_on_tick(idf->type)) continue;
-                if (idf->tick_rate_hz <= 0.0f || idf->tick_phase == std::string("after")) continue;
-                inst->tick_acc += dt;
-                float period = 1.0f / std::max(1.0f, idf->tick_rate_hz);
-                while (inst->tick_acc >= period && tick_calls < MAX_TICKS) {
-                    luam->call_item_on_tick(inst->def_type, *plbt, period);
-                    inst->tick_acc -= period;
-                    ++tick_calls;
-                }
-            }
+namespace {
+
+// Per-phase call caps; hosts over budget keep accumulating and catch up in
+// later frames.
+constexpr int TICK_BUDGET[TICK_PHASE_COUNT] = {2000, 2000};
+
+// Due entities of on_step_batch types, gathered during a phase and flushed
+// as one Lua call per type; kept across frames to reuse capacity.
+std::vector<std::pair<int, std::vector<VID>>> g_step_batches;
+
+void batch_entity(int def_type, VID vid) {
+    for (auto& [type, vids] : g_step_batches)
+        if (type == def_type) {
+            vids.push_back(vid);
+            return;
+        }
+    g_step_batches.emplace_back(def_type, std::vector<VID>{vid});
+}
+
+void flush_step_batches() {
+    for (auto& [type, vids] : g_step_batches) {
+        if (vids.empty()) continue;
+        luam->call_entity_on_step_batch(type, vids.data(), vids.size());
+        vids.clear();
+    }
+}
+
+template <typename Def>
+void add_host(const Def* d, bool has_hook, TickHostKind kind, VID vid, VID owner) {
+    if (!d || !has_hook || d->tick_rate_hz <= 0.0f)
+        return;
+    TickHost h{};
+    h.vid = vid;
+    h.owner = owner;
+    h.def_type = d->type;
+    h.period = 1.0f / std::max(1.0f, d->tick_rate_hz);
+    h.kind = kind;
+    ss->tick_hosts.add(d->tick_phase, h);
+}
+
+// Out of calls, or the phase's Lua instruction budget (lua/watchdog.hpp) is gone.
+bool over_budget(int calls, int budget) {
+    return calls >= budget || lua_watch_phase_spent();
+}
+
+// One host's due calls. Returns false if the host is gone and should be
+// dropped from the list.
+bool run_host(TickHost& h, int& calls, int budget) {
+    switch (h.kind) {
+    case TICK_HOST_GUN: {
+        GunInstance* gi = ss->guns.get(h.vid);
+        Entity* owner = ss->entities.get_mut(h.owner);
+        if (!gi || !owner) return false;
+        LuaInstanceGuard _inst(INV_GUN, h.vid); // timers started here belong to the gun
+        h.acc += TIMESTEP;
+        while (h.acc >= h.period && !over_budget(calls, budget)) {
+            luam->call_gun_on_step(h.def_type, *owner);
+            h.acc -= h.period;
+            ++calls;
+        }
+        return true;
+    }
+    case TICK_HOST_ITEM: {
+        ItemInstance* inst = ss->items.get(h.vid);
+        Entity* owner = ss->entities.get_mut(h.owner);
+        if (!inst || !owner) return false;
+        LuaInstanceGuard _inst(INV_ITEM, h.vid);
+        h.acc += TIMESTEP;
+        while (h.acc >= h.period && !over_budget(calls, budget)) {
+            luam->call_item_on_tick(h.def_type, *owner, h.period);
+            h.acc -= h.period;
+            ++calls;
         }
+        return true;
     }
-    // Entity type on_step ticks (before phase)
-    if (luam) {
-        const float dt = TIMESTEP;
-        const int MAX_TICKS = 4000;
-        int tick_calls = 0;
-        for (auto& e : ss->entities.data()) {
-            if (!e.active || e.def_type == 0) continue;
-            const auto* ed = luam->find_entity_type(e.def_type);
-            if (!ed) continue;
-            if (ed->tick_rate_hz <= 0.0f || ed->tick_phase == std::string("after") || !luam->has_entity_on_step(ed->type)) continue;
-            e.tick_acc_entity += dt;
-            float period = 1.0f / std::max(1.0f, ed->tick_rate_hz);
-            while (e.tick_acc_entity >= period && tick_calls < MAX_TICKS) {
-                luam->call_entity_on_step(e.def_type, e);
-                e.tick_acc_entity -= period;
-                ++tick_calls;
-            }
+    case TICK_HOST_ENTITY: {
+        Entity* e = ss->entities.get_mut(h.vid);
+        if (!e || e->def_type != h.def_type) return false;
+        const bool batched = luam->has_entity_on_step_batch(h.def_type);
+        h.acc += TIMESTEP;
+        while (h.acc >= h.period && !over_budget(calls, budget)) {
+            if (batched)
+                batch_entity(h.def_type, h.vid);
+            else
+                luam->call_entity_on_step(h.def_type, *e);
+            h.acc -= h.period;
+            ++calls;
         }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void run_phase(TickPhase ph) {
+    if (!ss || !luam) return;
+    auto& list = ss->tick_hosts.phases[ph];
+    std::size_t& cursor = ss->tick_hosts.cursor[ph];
+    // Hosts registered by a tick wait for the next frame; index rather than
+    // reference, since a Lua call may grow the list.
+    const std::size_t n = list.size();
+    const int budget = TICK_BUDGET[ph];
+    int calls = 0;
+    std::size_t start = n ? cursor % n : 0;
+    std::optional<std::size_t> resume; // first host the budget did not reach
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t i = (start + k) % n;
+        if (!resume && over_budget(calls, budget)) resume = i;
+        TickHost h = list[i];
+        if (h.kind == TICK_HOST_DEAD) continue;
+        bool alive = run_host(h, calls, budget);
+        // A tick may have unregistered this host meanwhile; keep that.
+        if (list[i].kind == TICK_HOST_DEAD) continue;
+        list[i] = h;
+        if (!alive) list[i].kind = TICK_HOST_DEAD;
     }
+    flush_step_batches();
+    const std::size_t next = ss->tick_hosts.compact(ph, resume.value_or(0));
+    cursor = resume ? next : 0;
+}
+
+} // namespace
+
+void pre_physics_ticks() {
+    lua_watch_phase_begin();
+    run_phase(TICK_BEFORE_PHYSICS);
+    if (luam) luam->run_timers(TICK_BEFORE_PHYSICS);
+    lua_watch_phase_end();
 }
 
 void post_physics_ticks() {
-    if (!ss) return;
-    // Player inventory-driven hooks (after phase)
-    Entity* plat = ss->player_vid ? ss->entities.get_mut(*ss->player_vid) : nullptr;
-    if (plat && luam) {
-        const float dt = TIMESTEP;
-        const int MAX_TICKS = 4000;
-        int tick_calls = 0;
-        // Guns with on_step
-        if (auto* inv = ss->inv_for(*ss->player_vid)) for (const auto& entry : inv->entries) {
-            if (entry.kind != INV_GUN) continue;
-            GunInstance* gi = ss->guns.get(entry.vid);
-            if (!gi) continue;
-            const GunDef* gd = nullptr;
-            for (auto const& g : luam->guns()) if (g.type == gi->def_type) { gd = &g; break; }
-            if (!gd || !luam->has_gun_on_step(gd->type)) continue;
-            if (gd->tick_rate_hz <= 0.0f || gd->tick_phase == std::string("before")) continue;
-            gi->tick_acc += dt;
-            float period = 1.0f / std::max(1.0f, gd->tick_rate_hz);
-            while (gi->tick_acc >= period && tick_calls < MAX_TICKS) {
-                luam->call_gun_on_step(gi->def_type, *plat);
-                gi->tick_acc -= period;
-                ++tick_calls;
-            }
-        }
-        // Items with on_tick
-        if (auto* inv = ss->inv_for(*ss->player_vid)) for (const auto& entry : inv->entries) {
-            if (entry.kind != INV_ITEM) continue;
-            ItemInstance* inst = ss->items.get(entry.vid);
-            if (!inst) continue;
-            const ItemDef* idf = nullptr;
-            for (auto const& d : luam->items()) if (d.type == inst->def_type) { idf = &d; break; }
-            if (!idf || !luam->has_item_on_tick(idf->type)) continue;
-            if (idf->tick_rate_hz <= 0.0f || idf->tick_phase == std::string("before")) continue;
-            inst->tick_acc += dt;
-            float period = 1.0f / std::max(1.0f, idf->tick_rate_hz);
-            while (inst->tick_acc >= period && tick_calls < MAX_TICKS) {
-                luam->call_item_on_tick(inst->def_type, *plat, period);
-                inst->tick_acc -= period;
-                ++tick_calls;
-            }
-        }
+    lua_watch_phase_begin();
+    run_phase(TICK_AFTER_PHYSICS);
+    if (luam) luam->run_timers(TICK_AFTER_PHYSICS);
+    lua_watch_phase_end();
+}
+
+void tick_register_entity(const Entity& e) {
+    if (!ss || !luam || e.def_type == 0) return;
+    bool hook = luam->has_entity_on_step(e.def_type) || luam->has_entity_on_step_batch(e.def_type);
+    add_host(luam->find_entity_type(e.def_type), hook, TICK_HOST_ENTITY, e.vid, VID{});
+}
+
+void tick_unregister_entity(VID vid) {
+    if (ss) ss->tick_hosts.remove(TICK_HOST_ENTITY, vid);
+}
+
+void tick_register_inv(int kind, VID vid, VID owner) {
+    if (!ss || !luam) return;
+    if (kind == INV_GUN) {
+        if (const GunInstance* gi = ss->guns.get(vid))
+            add_host(luam->find_gun(gi->def_type), luam->has_gun_on_step(gi->def_type), TICK_HOST_GUN, vid, owner);
+    } else if (kind == INV_ITEM) {
+        if (const ItemInstance* inst = ss->items.get(vid))
+            add_host(luam->find_item(inst->def_type), luam->has_item_on_tick(inst->def_type), TICK_HOST_ITEM, vid,
+                     owner);
     }
-    // Entity type on_step ticks (after phase)
-    if (luam) {
-        const int MAX_TICKS = 4000;
-        int tick_calls = 0;
-        for (auto& e : ss->entities.data()) {
-            if (!e.active || e.def_type == 0) continue;
-            const auto* ed = luam->find_entity_type(e.def_type);
-            if (!ed) continue;
-            if (ed->tick_rate_hz <= 0.0f || ed->tick_phase != std::string("after") || !luam->has_entity_on_step(ed->type)) continue;
-            e.tick_acc_entity += TIMESTEP;
-            float period = 1.0f / std::max(1.0f, ed->tick_rate_hz);
-            while (e.tick_acc_entity >= period && tick_calls < MAX_TICKS) {
-                luam->call_entity_on_step(e.def_type, e);
-                e.tick_acc_entity -= period;
-                ++tick_calls;
-            }
+}
+
+void tick_unregister_inv(int kind, VID vid) {
+    if (ss) ss->tick_hosts.remove(kind == INV_GUN ? TICK_HOST_GUN : TICK_HOST_ITEM, vid);
+}
+
+std::size_t tick_missing_inv_hosts() {
+    if (!ss || !luam || !ss->player_vid) return 0;
+    const Inventory* inv = ss->inv_for(*ss->player_vid);
+    if (!inv) return 0;
+    const VID owner = *ss->player_vid;
+    auto hosted = [&](std::uint8_t kind, VID vid) {
+        const TickHost* h = ss->tick_hosts.find(kind, vid);
+        return h && h->owner.id == owner.id && h->owner.version == owner.version;
+    };
+    std::size_t missing = 0;
+    for (const auto& entry : inv->entries) {
+        if (entry.kind == INV_GUN) {
+            const GunInstance* gi = ss->guns.get(entry.vid);
+            const GunDef* d = gi ? luam->find_gun(gi->def_type) : nullptr;
+            if (d && d->tick_rate_hz > 0.0f && luam->has_gun_on_step(d->type) && !hosted(TICK_HOST_GUN, entry.vid))
+                ++missing;
+        } else if (entry.kind == INV_ITEM) {
+            const ItemInstance* inst = ss->items.get(entry.vid);
+            const ItemDef* d = inst ? luam->find_item(inst->def_type) : nullptr;
+            if (d && d->tick_rate_hz > 0.0f && luam->has_item_on_tick(d->type) && !hosted(TICK_HOST_ITEM, entry.vid))
+                ++missing;
         }
     }
+    return missing;
+}
+
+void tick_rebuild_hosts() {
+    if (!ss) return;
+    ss->tick_hosts.clear();
+    if (ss->player_vid)
+        if (const Inventory* inv = ss->inv_for(*ss->player_vid))
+            for (const auto& entry : inv->entries)
+                tick_register_inv(entry.kind, entry.vid, *ss->player_vid);
+    for (std::size_t id : ss->entities.active_ids())
+        tick_register_entity(ss->entities.by_id(id));
 }
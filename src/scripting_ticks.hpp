@@ -1,10 +1,31 @@
 // Lua-driven ticking for guns/items/entities.
 // Responsibility: run registered Lua hooks on a fixed cadence in pre-/post-
-// physics phases.
+// physics phases, over the hosts registered in ss->tick_hosts.
 #pragma once
 
+#include "types.hpp"
+
+#include <cstddef>
+
+struct Entity;
+
 // Pre-physics phase.
 void pre_physics_ticks();
 
-// Post-physics: guns/items with after-phase on_step/on_tick and entity after-phase.
+// Post-physics phase.
 void post_physics_ticks();
+
+// Host registration. Each call is a no-op unless the def opts into ticking
+// (tick_rate_hz > 0 and a tick hook). Guns/items register while they sit in
+// the player's inventory; entities from spawn until death.
+void tick_register_entity(const Entity& e);
+void tick_unregister_entity(VID vid);
+void tick_register_inv(int kind, VID vid, VID owner);
+void tick_unregister_inv(int kind, VID vid);
+// Re-derive every host from the player's inventory and the live entities;
+// for when defs change (script reload) or the player is re-created (room
+// change).
+void tick_rebuild_hosts();
+// Player inventory guns/items that opt into ticking but have no live host
+// owned by the current player; 0 unless registration was missed.
+std::size_t tick_missing_inv_hosts();
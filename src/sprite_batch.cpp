@@ -0,0 +1,73 @@
+#include "sprite_batch.hpp"
+#include "globals.hpp"
+#include "graphics.hpp"
+
+#include <cmath>
+
+namespace {
+
+SpriteBatch::Bucket& bucket_for(SpriteBatch& b, SDL_Texture* tex) {
+    if (b.last < b.used && b.buckets[b.last].tex == tex) return b.buckets[b.last];
+    for (std::size_t i = 0; i < b.used; ++i)
+        if (b.buckets[i].tex == tex) {
+            b.last = i;
+            return b.buckets[i];
+        }
+    if (b.used == b.buckets.size()) b.buckets.emplace_back();
+    b.last = b.used++;
+    SpriteBatch::Bucket& k = b.buckets[b.last];
+    k.tex = tex;
+    k.verts.clear();
+    return k;
+}
+
+void push_quad(SDL_Texture* tex, const SDL_FRect& uv, const SDL_Rect& dst, float angle_deg, SDL_Color col) {
+    if (!gg) return;
+    auto& verts = bucket_for(gg->batch, tex).verts;
+    const float x0 = static_cast<float>(dst.x), y0 = static_cast<float>(dst.y);
+    const float x1 = x0 + static_cast<float>(dst.w), y1 = y0 + static_cast<float>(dst.h);
+    SDL_FPoint p[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+    if (angle_deg != 0.0f) {
+        const float cx = (x0 + x1) * 0.5f, cy = (y0 + y1) * 0.5f;
+        const float rad = angle_deg * 3.14159265f / 180.0f;
+        const float cs = std::cos(rad), sn = std::sin(rad);
+        for (auto& q : p) {
+            float dx = q.x - cx, dy = q.y - cy;
+            q = SDL_FPoint{cx + dx * cs - dy * sn, cy + dx * sn + dy * cs};
+        }
+    }
+    const float u0 = uv.x, v0 = uv.y, u1 = uv.x + uv.w, v1 = uv.y + uv.h;
+    verts.push_back(SDL_Vertex{p[0], col, SDL_FPoint{u0, v0}});
+    verts.push_back(SDL_Vertex{p[1], col, SDL_FPoint{u1, v0}});
+    verts.push_back(SDL_Vertex{p[2], col, SDL_FPoint{u1, v1}});
+    verts.push_back(SDL_Vertex{p[3], col, SDL_FPoint{u0, v1}});
+}
+
+} // namespace
+
+void batch_sprite(const SpriteTex& st, const SDL_Rect& dst, float angle_deg) {
+    push_quad(st.tex, st.uv, dst, angle_deg, SDL_Color{255, 255, 255, 255});
+}
+
+void batch_fill(const SDL_Rect& dst, SDL_Color col) {
+    push_quad(nullptr, SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f}, dst, 0.0f, col);
+}
+
+void flush_sprite_batch() {
+    if (!gg) return;
+    SpriteBatch& b = gg->batch;
+    for (std::size_t i = 0; i < b.used; ++i) {
+        auto& k = b.buckets[i];
+        const std::size_t quads = k.verts.size() / 4;
+        for (std::size_t q = b.indices.size() / 6; q < quads; ++q) {
+            int v = static_cast<int>(q * 4);
+            b.indices.insert(b.indices.end(), {v, v + 1, v + 2, v, v + 2, v + 3});
+        }
+        if (quads > 0 && gg->renderer)
+            SDL_RenderGeometry(gg->renderer, k.tex, k.verts.data(), static_cast<int>(k.verts.size()),
+                               b.indices.data(), static_cast<int>(quads * 6));
+        k.verts.clear();
+    }
+    b.used = 0;
+    b.last = 0;
+}
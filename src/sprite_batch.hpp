@@ -0,0 +1,32 @@
+// Sprite batch.
+// Responsibility: collect world sprite quads (optionally rotated, or flat
+// colour) per texture and submit each texture's quads with one
+// SDL_RenderGeometry call.
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <vector>
+#include "atlas.hpp"
+
+struct SpriteBatch {
+    struct Bucket {
+        SDL_Texture* tex{nullptr}; // atlas page; nullptr => flat-colour quads
+        std::vector<SDL_Vertex> verts;
+    };
+    // Buckets in first-use order; the first `used` are live. Kept across
+    // flushes so their vectors keep their capacity.
+    std::vector<Bucket> buckets;
+    std::size_t used{0};
+    std::size_t last{0};      // bucket of the previous quad
+    std::vector<int> indices; // 6 per quad, shared by every submit
+};
+
+// Queue sprite `st` over `dst`, rotated by `angle_deg` about its centre
+// (clockwise, as SDL_RenderCopyEx).
+void batch_sprite(const SpriteTex& st, const SDL_Rect& dst, float angle_deg = 0.0f);
+// Queue a filled rect in `col` (drawn with the flat-colour quads).
+void batch_fill(const SDL_Rect& dst, SDL_Color col);
+// Submit everything queued, one call per texture in first-use order. Quads of
+// one layer may be reordered across textures, so flush between layers.
+void flush_sprite_batch();
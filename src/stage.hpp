@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -20,10 +22,28 @@ struct TileProps {
     }
 };
 
+// Bitplane selectors for Stage::any_blocked (same bits as TileProps::flags)
+enum TileMask : std::uint8_t {
+    MASK_BLOCKS_ENTITIES = 0x1,
+    MASK_BLOCKS_PROJECTILES = 0x2,
+};
+
+// Tile grid. Alongside the TileProps array, each blocking flag is mirrored
+// into a bitplane of 64-bit words (one padded run of words per row) so rect
+// queries test up to 64 tiles per load. All writes go through set(), which
+// also bumps the revision of the CHUNK x CHUNK block the tile is in so cached
+// renders of it can tell they are stale.
 struct Stage {
   public:
-    Stage(uint32_t w = 64, uint32_t h = 36) : width(w), height(h) {
+    static constexpr uint32_t CHUNK = 16; // tiles per chunk side
+
+    Stage(uint32_t w = 64, uint32_t h = 36)
+        : width(w), height(h), row_words((w + 63) / 64), chunks_w((w + CHUNK - 1) / CHUNK),
+          chunks_h((h + CHUNK - 1) / CHUNK) {
         tiles.resize(width * height);
+        plane_entities.assign(static_cast<std::size_t>(row_words) * height, 0);
+        plane_projectiles.assign(static_cast<std::size_t>(row_words) * height, 0);
+        chunk_revs.assign(static_cast<std::size_t>(chunks_w) * chunks_h, 0);
     }
 
     uint32_t get_width() const {
@@ -33,30 +53,91 @@ struct Stage {
         return height;
     }
 
+    uint32_t get_chunks_w() const {
+        return chunks_w;
+    }
+    uint32_t get_chunks_h() const {
+        return chunks_h;
+    }
+    // Bumped whenever a tile in chunk (cx, cy) changes
+    uint32_t chunk_rev(uint32_t cx, uint32_t cy) const {
+        return chunk_revs[cy * chunks_w + cx];
+    }
+
     bool in_bounds(int x, int y) const {
         return x >= 0 && y >= 0 && (uint32_t)x < width && (uint32_t)y < height;
     }
 
-    TileProps& at(int x, int y) {
-        return tiles[(uint32_t)y * width + (uint32_t)x];
-    }
     const TileProps& at(int x, int y) const {
         return tiles[(uint32_t)y * width + (uint32_t)x];
     }
 
+    void set(int x, int y, TileProps t) {
+        TileProps& cur = tiles[(uint32_t)y * width + (uint32_t)x];
+        if (cur.flags != t.flags)
+            chunk_revs[((uint32_t)y / CHUNK) * chunks_w + (uint32_t)x / CHUNK] += 1;
+        cur = t;
+        std::size_t w = word_index(x, y);
+        std::uint64_t bit = std::uint64_t{1} << ((uint32_t)x % 64);
+        plane_entities[w] = t.blocks_entities() ? (plane_entities[w] | bit) : (plane_entities[w] & ~bit);
+        plane_projectiles[w] = t.blocks_projectiles() ? (plane_projectiles[w] | bit) : (plane_projectiles[w] & ~bit);
+    }
+
     void fill_border(TileProps t) {
         for (uint32_t x = 0; x < width; ++x) {
-            at((int)x, 0) = t;
-            at((int)x, (int)height - 1) = t;
+            set((int)x, 0, t);
+            set((int)x, (int)height - 1, t);
         }
         for (uint32_t y = 0; y < height; ++y) {
-            at(0, (int)y) = t;
-            at((int)width - 1, (int)y) = t;
+            set(0, (int)y, t);
+            set((int)width - 1, (int)y, t);
+        }
+    }
+
+    // True if any tile in the inclusive tile rect [minx, maxx] x [miny, maxy]
+    // has a flag in `mask`. Tiles outside the stage count as blocked only
+    // when outside_blocks is set (entities collide with the edge, projectiles
+    // fly off it).
+    bool any_blocked(int minx, int miny, int maxx, int maxy, std::uint8_t mask, bool outside_blocks) const {
+        if (minx > maxx || miny > maxy)
+            return false;
+        int x0 = std::max(minx, 0), y0 = std::max(miny, 0);
+        int x1 = std::min(maxx, (int)width - 1), y1 = std::min(maxy, (int)height - 1);
+        if (outside_blocks && (x0 != minx || y0 != miny || x1 != maxx || y1 != maxy))
+            return true;
+        if (x0 > x1 || y0 > y1)
+            return false;
+        bool use_e = (mask & MASK_BLOCKS_ENTITIES) != 0, use_p = (mask & MASK_BLOCKS_PROJECTILES) != 0;
+        std::size_t w0 = (uint32_t)x0 / 64, w1 = (uint32_t)x1 / 64;
+        std::uint64_t first = ~std::uint64_t{0} << ((uint32_t)x0 % 64);
+        std::uint64_t last = ~std::uint64_t{0} >> (63 - (uint32_t)x1 % 64);
+        for (int y = y0; y <= y1; ++y) {
+            std::size_t row = (uint32_t)y * std::size_t{row_words};
+            for (std::size_t w = w0; w <= w1; ++w) {
+                std::uint64_t bits = (use_e ? plane_entities[row + w] : 0) | (use_p ? plane_projectiles[row + w] : 0);
+                if (w == w0)
+                    bits &= first;
+                if (w == w1)
+                    bits &= last;
+                if (bits)
+                    return true;
+            }
         }
+        return false;
     }
 
   private:
+    std::size_t word_index(int x, int y) const {
+        return (uint32_t)y * std::size_t{row_words} + (uint32_t)x / 64;
+    }
+
     uint32_t width;
     uint32_t height;
+    uint32_t row_words; // 64-bit words per bitplane row
+    uint32_t chunks_w;
+    uint32_t chunks_h;
     std::vector<TileProps> tiles;
+    std::vector<std::uint64_t> plane_entities;
+    std::vector<std::uint64_t> plane_projectiles;
+    std::vector<std::uint32_t> chunk_revs;
 };
@@ -2,6 +2,7 @@
 
 #include "crates.hpp"
 #include "entities.hpp"
+#include "entity_grid.hpp"
 #include "guns.hpp"
 #include "input.hpp"
 #include "inventory.hpp"
@@ -10,8 +11,10 @@
 #include "pickups.hpp"
 #include "projectiles.hpp"
 #include "stage.hpp"
+#include "tick_hosts.hpp"
 #include "types.hpp"
 #include "runtime_settings.hpp"
+#include "worker_pool.hpp"
 
 #include <cstdint>
 #include <glm/glm.hpp>
@@ -56,6 +59,7 @@ struct State {
 
     Entities entities{};
     std::optional<VID> player_vid{};
+    TickHosts tick_hosts{}; // see scripting_ticks.hpp
     Particles particles{};
     Stage stage{64, 36};
     Inventory inventory = Inventory::make(); // legacy: use per-entity via inv_for()
@@ -68,12 +72,17 @@ struct State {
     int default_crate_type{0};
     // Projectiles (moved into State)
     Projectiles projectiles{};
+    // Broadphase over active entities; rebuilt each tick before projectiles step
+    EntityGrid entity_grid{};
+    // Worker threads for parallel stepping (1 => everything on the main thread)
+    WorkerPool workers{};
 
     // Firing cooldown (seconds)
     float gun_cooldown{0.0f};
     // Jam base chance additive
     float base_jam_chance{0.02f};
 
+    // Set when the room is regenerated; the tile layer redraws every chunk
     bool rebuild_render_texture{true};
     float cloud_density{0.5f};
 
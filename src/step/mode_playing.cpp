@@ -9,53 +9,71 @@
 #include "scripting_ticks.hpp"
 #include "projectiles_step.hpp"
 #include "player_movement.hpp"
+#include "task_graph.hpp"
 
 #include <algorithm>
 
-// One fixed-timestep simulation tick for MODE_PLAYING.
-void step_playing() {
-    // Before-physics ticking (opt-in)
-    pre_physics_ticks();
-
-    // Movement + physics: player controlled + NPC wander; keep inside non-block tiles
-    update_movement_and_collision();
-
-    // Shield regen + reload progress
-    update_shields_and_reload_progress();
+namespace {
 
-    // Auto-pickup powerups on overlap
-    auto_pickup_powerups();
-
-    // Manual pickup + separation
-    if (ss->player_vid) {
+void manual_pickups() {
+    if (ss->player_vid)
         handle_manual_pickups();
-        separate_ground_items();
-    }
+}
 
-    // Toggle drop mode and handle number row actions
-    toggle_drop_mode();
-    handle_inventory_hotbar();
+void separate_ground() {
+    if (ss->player_vid)
+        separate_ground_items();
+}
 
-    // Accumulate metrics and decrement lockouts
+// Accumulate metrics and decrement lockouts
+void tick_timers() {
     ss->metrics.time_in_stage += TIMESTEP;
     ss->input_lockout_timer = std::max(0.0f, ss->input_lockout_timer - TIMESTEP);
     ss->pickup_lockout = std::max(0.0f, ss->pickup_lockout - TIMESTEP);
+}
 
-    // Exit countdown and transitions
-    update_exit_countdown();
-    start_score_review_if_ready();
-
-    // Camera follow
-    update_camera_follow();
-
-    // Combat: reload edges + firing + unjam
-    update_reload_active();
-    update_trigger_and_fire();
-    update_unjam();
+// Phases in tick order with the state each touches. Anything that can reach
+// Lua (ticks, hooks, on_* callbacks) takes RES_ALL and acts as a barrier.
+const TaskGraph& playing_graph() {
+    static const TaskGraph graph({
+        // Before-physics ticking (opt-in)
+        {"pre_physics_ticks", pre_physics_ticks, RES_ALL, RES_ALL},
+        // Movement + physics: player controlled + NPC wander; keep inside non-block tiles
+        {"movement", update_movement_and_collision, RES_ALL, RES_ALL},
+        // Shield regen + reload progress
+        {"shields_reload", update_shields_and_reload_progress, RES_ALL, RES_ALL},
+        // Auto-pickup powerups on overlap
+        {"auto_pickup", auto_pickup_powerups, RES_ENTITIES | RES_PROGRESSION,
+         RES_PICKUPS | RES_ALERTS | RES_METRICS},
+        // Manual pickup + separation
+        {"manual_pickups", manual_pickups, RES_ALL, RES_ALL},
+        {"separate_ground", separate_ground, RES_GROUND, RES_GROUND},
+        // Toggle drop mode and handle number row actions
+        {"toggle_drop", toggle_drop_mode, RES_INPUTS, RES_INVENTORY | RES_ALERTS},
+        {"hotbar", handle_inventory_hotbar, RES_ALL, RES_ALL},
+        {"timers", tick_timers, 0, RES_METRICS | RES_TIMERS},
+        // Exit countdown and transitions
+        {"exit_countdown", update_exit_countdown, RES_ENTITIES | RES_PROGRESSION, RES_PROGRESSION | RES_ALERTS},
+        {"score_review", start_score_review_if_ready, RES_ENTITIES | RES_METRICS | RES_PROGRESSION,
+         RES_PROGRESSION | RES_METRICS | RES_ALERTS},
+        // Camera follow; queries the renderer's output size
+        {"camera", update_camera_follow, RES_ENTITIES | RES_INPUTS, RES_CAMERA, true},
+        // Combat: reload edges + firing + unjam
+        {"reload_active", update_reload_active, RES_ALL, RES_ALL},
+        {"fire", update_trigger_and_fire, RES_ALL, RES_ALL},
+        {"unjam", update_unjam, RES_ENTITIES | RES_INPUTS | RES_PROGRESSION,
+         RES_INVENTORY | RES_METRICS | RES_ALERTS | RES_PLAYER_FX | RES_AUDIO},
+        // Projectiles update; steps its lanes across the pool itself
+        {"projectiles", step_projectiles_and_hits, RES_ALL, RES_ALL},
+        // After-physics ticking (opt-in)
+        {"post_physics_ticks", post_physics_ticks, RES_ALL, RES_ALL},
+    });
+    return graph;
+}
 
-    // Projectiles update
-    step_projectiles_and_hits();
+} // namespace
 
-    // After-physics ticking (opt-in)
-    post_physics_ticks();
+// One fixed-timestep simulation tick for MODE_PLAYING.
+void step_playing() {
+    playing_graph().run(&ss->workers);
 }
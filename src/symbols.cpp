@@ -0,0 +1,30 @@
+#include "symbols.hpp"
+
+#include <cstdio>
+#include <unordered_map>
+
+namespace {
+
+std::unordered_map<Sym, std::string>& names() {
+    static std::unordered_map<Sym, std::string> table;
+    return table;
+}
+
+} // namespace
+
+std::optional<Sym> intern(std::string_view key) {
+    Sym s = sym_of(key);
+    auto [it, added] = names().try_emplace(s, key);
+    if (!added && it->second != key) {
+        std::fprintf(stderr, "[sym] id collision: '%.*s' refused, '%s' holds %08x\n", static_cast<int>(key.size()),
+                     key.data(), it->second.c_str(), s.id);
+        return std::nullopt;
+    }
+    return s;
+}
+
+const std::string& sym_name(Sym s) {
+    static const std::string none;
+    auto it = names().find(s);
+    return it == names().end() ? none : it->second;
+}
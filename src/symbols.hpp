@@ -0,0 +1,57 @@
+// Interned asset keys.
+// Responsibility: give namespaced keys ("mod:name") stable 32-bit ids. An id
+// is the key's FNV-1a hash, so engine literals resolve at compile time
+// ("base:ui_cant"_sym) and match the ids interned from mod files at load.
+// Two keys sharing an id is refused at intern time, and registries keep each
+// id's name so lookups can confirm the key they were asked for.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+struct Sym {
+    std::uint32_t id{0};
+    friend constexpr bool operator==(Sym, Sym) = default;
+};
+
+constexpr Sym sym_of(std::string_view key) {
+    std::uint32_t h = 2166136261u;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return Sym{h};
+}
+
+// A key and its id, for lookups that must confirm the name behind the id.
+struct SymKey {
+    Sym sym;
+    std::string_view name;
+};
+
+constexpr SymKey sym_key(std::string_view key) {
+    return SymKey{sym_of(key), key};
+}
+
+consteval SymKey operator""_sym(const char* s, std::size_t n) {
+    return sym_key(std::string_view{s, n});
+}
+
+template <>
+struct std::hash<Sym> {
+    std::size_t operator()(Sym s) const noexcept {
+        return s.id;
+    }
+};
+
+// Returns sym_of(key) and remembers the name. Nullopt (and a log line) if a
+// different key already holds that id; the caller refuses the asset.
+// Load-time only; not thread-safe.
+std::optional<Sym> intern(std::string_view key);
+
+// Name recorded by intern(), or "" if the id was never interned.
+const std::string& sym_name(Sym s);
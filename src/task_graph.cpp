@@ -0,0 +1,67 @@
+#include "task_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace {
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+TaskGraph::TaskGraph(std::vector<Phase> list) : phases(std::move(list)), cost_ns(phases.size(), 0) {
+    std::vector<std::size_t> level(phases.size(), 0);
+    std::size_t depth = 0;
+    for (std::size_t j = 0; j < phases.size(); ++j) {
+        auto const& b = phases[j];
+        for (std::size_t i = 0; i < j; ++i) {
+            auto const& a = phases[i];
+            bool conflict = (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+            if (conflict)
+                level[j] = std::max(level[j], level[i] + 1);
+        }
+        depth = std::max(depth, level[j] + 1);
+    }
+    waves.resize(depth);
+    for (std::size_t j = 0; j < phases.size(); ++j) {
+        auto& w = waves[level[j]];
+        (phases[j].main_thread ? w.local : w.pooled).push_back(static_cast<std::uint32_t>(j));
+    }
+}
+
+void TaskGraph::run(WorkerPool* pool) const {
+    if (!pool || pool->threads() == 1) {
+        for (auto const& p : phases)
+            p.fn();
+        return;
+    }
+    auto timed = [&](std::uint32_t j) {
+        std::int64_t t0 = now_ns();
+        phases[j].fn();
+        cost_ns[j] = now_ns() - t0;
+    };
+    for (auto const& w : waves) {
+        for (std::uint32_t j : w.local)
+            phases[j].fn();
+        // Costs start at 0, so every wave runs inline once before it can
+        // be pooled
+        std::int64_t sum = 0, longest = 0;
+        for (std::uint32_t j : w.pooled) {
+            sum += cost_ns[j];
+            longest = std::max(longest, cost_ns[j]);
+        }
+        if (w.pooled.size() < 2) {
+            if (!w.pooled.empty())
+                phases[w.pooled[0]].fn();
+        } else if (sum - longest < MIN_POOLED_NS) {
+            for (std::uint32_t j : w.pooled)
+                timed(j);
+        } else {
+            pool->run(w.pooled.size(), [&](std::size_t k) { timed(w.pooled[k]); });
+        }
+    }
+}
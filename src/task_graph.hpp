@@ -0,0 +1,72 @@
+// Phase scheduler over declared read/write sets.
+// Responsibility: order a fixed list of tick phases into dependency waves
+// once, then run each wave's phases concurrently on a WorkerPool when that
+// is worth a handoff.
+#pragma once
+
+#include "worker_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// State a phase reads or writes. Phases that can call into Lua declare
+// RES_ALL for both: scripts reach any state through the API.
+enum PhaseRes : std::uint32_t {
+    RES_ENTITIES = 1u << 0,
+    RES_STAGE = 1u << 1,
+    RES_INPUTS = 1u << 2,
+    RES_TIMERS = 1u << 3,      // input/pickup lockouts
+    RES_PLAYER_FX = 1u << 4,   // reticle and reload-bar shake
+    RES_PICKUPS = 1u << 5,
+    RES_GROUND = 1u << 6,      // ground items, ground guns, crates
+    RES_INVENTORY = 1u << 7,   // inventories, item/gun instances, drop mode
+    RES_METRICS = 1u << 8,
+    RES_ALERTS = 1u << 9,
+    RES_PROGRESSION = 1u << 10, // mode, exit countdown, score review
+    RES_CAMERA = 1u << 11,
+    RES_PROJECTILES = 1u << 12,
+    RES_AUDIO = 1u << 13,
+    RES_ALL = ~0u,
+};
+
+struct Phase {
+    const char* name;
+    void (*fn)();
+    std::uint32_t reads;
+    std::uint32_t writes;
+    bool main_thread{false}; // touches SDL video state; never handed to a worker
+};
+
+struct TaskGraph {
+  public:
+    // Phase j depends on every earlier phase i whose sets conflict with it
+    // (i writes what j reads or writes, or j writes what i reads); its wave
+    // is one past the deepest such i.
+    explicit TaskGraph(std::vector<Phase> phases);
+
+    // Runs every phase once. Conflicting phases keep their declared order,
+    // so the result matches running the list front to back. pool == nullptr
+    // or a single-thread pool => exactly that, on this thread. Phases that
+    // share a wave must not use the pool themselves; a phase alone in its
+    // wave runs on this thread and may. A wave whose phases took too little
+    // time last tick to gain from a handoff also runs here, in order.
+    void run(WorkerPool* pool) const;
+
+    // Work a pooled wave must save (its summed phase time minus its longest
+    // phase) to be handed to the pool; a wake and barrier costs about this.
+    static constexpr std::int64_t MIN_POOLED_NS = 50'000;
+
+    std::size_t wave_count() const {
+        return waves.size();
+    }
+
+  private:
+    struct Wave {
+        std::vector<std::uint32_t> local;  // main_thread phases, run here first
+        std::vector<std::uint32_t> pooled; // everything else
+    };
+    std::vector<Phase> phases;
+    std::vector<Wave> waves;
+    mutable std::vector<std::int64_t> cost_ns; // per phase, from its last run
+};
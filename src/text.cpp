@@ -0,0 +1,199 @@
+#include "text.hpp"
+#include "globals.hpp"
+#include "graphics.hpp"
+
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+constexpr int GLYPH_PAD = 1;                // keeps filtering from bleeding between glyphs
+constexpr std::uint32_t LAYOUT_TTL = 120;   // frames without a draw before a layout goes
+constexpr std::uint32_t SWEEP_EVERY = 64;   // frames between TTL sweeps
+constexpr std::size_t LAYOUT_MAX = 4096;    // hard cap; past it the cache starts over
+
+// Malformed sequences come out as U+FFFD.
+std::uint32_t next_codepoint(std::string_view s, std::size_t& i) {
+    auto byte = [&](std::size_t k) { return static_cast<std::uint32_t>(static_cast<unsigned char>(s[k])); };
+    std::uint32_t c = byte(i);
+    std::size_t extra = 0;
+    if (c < 0x80) { i += 1; return c; }
+    else if ((c & 0xE0) == 0xC0) { extra = 1; c &= 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { extra = 2; c &= 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { extra = 3; c &= 0x07; }
+    else { i += 1; return 0xFFFD; }
+    if (i + extra >= s.size()) { i = s.size(); return 0xFFFD; }
+    for (std::size_t k = 1; k <= extra; ++k) {
+        std::uint32_t cc = byte(i + k);
+        if ((cc & 0xC0) != 0x80) { i += k; return 0xFFFD; }
+        c = (c << 6) | (cc & 0x3F);
+    }
+    i += extra + 1;
+    return c;
+}
+
+bool ensure_atlas(TextCache& tc) {
+    if (tc.atlas) return true;
+    tc.atlas = SDL_CreateTexture(gg->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                 TextCache::ATLAS, TextCache::ATLAS);
+    if (!tc.atlas) {
+        std::fprintf(stderr, "[text] atlas texture failed: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(tc.atlas, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+// Every glyph and layout points into the atlas, so they all go together; the
+// texture itself is reused.
+void reset_atlas(TextCache& tc) {
+    tc.glyphs.clear();
+    tc.layouts.clear();
+    tc.shelf_x = tc.shelf_y = tc.shelf_h = 0;
+}
+
+// nullptr when the atlas is full.
+const Glyph* get_glyph(TextCache& tc, std::uint32_t cp) {
+    if (auto it = tc.glyphs.find(cp); it != tc.glyphs.end()) return &it->second;
+    Glyph g{};
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, adv = 0;
+    if (TTF_GlyphMetrics32(gg->ui_font, cp, &minx, &maxx, &miny, &maxy, &adv) == 0) {
+        g.advance = adv;
+        g.x_off = std::min(0, minx);
+    }
+    SDL_Surface* s = TTF_RenderGlyph32_Blended(gg->ui_font, cp, SDL_Color{255, 255, 255, 255});
+    if (s && s->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* conv = SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(s);
+        s = conv;
+    }
+    if (s && s->w > 0 && s->h > 0) {
+        if (tc.shelf_x + s->w > TextCache::ATLAS) {
+            tc.shelf_x = 0;
+            tc.shelf_y += tc.shelf_h + GLYPH_PAD;
+            tc.shelf_h = 0;
+        }
+        if (tc.shelf_y + s->h > TextCache::ATLAS) {
+            SDL_FreeSurface(s);
+            return nullptr;
+        }
+        g.src = SDL_Rect{tc.shelf_x, tc.shelf_y, s->w, s->h};
+        SDL_UpdateTexture(tc.atlas, &g.src, s->pixels, s->pitch);
+        tc.shelf_x += s->w + GLYPH_PAD;
+        tc.shelf_h = std::max(tc.shelf_h, s->h);
+    }
+    if (s) SDL_FreeSurface(s);
+    return &tc.glyphs.emplace(cp, g).first->second;
+}
+
+void push_quad(TextLayout& l, float x, const SDL_Rect& src) {
+    constexpr float inv = 1.0f / static_cast<float>(TextCache::ATLAS);
+    float x1 = x + static_cast<float>(src.w), y1 = static_cast<float>(src.h);
+    float u0 = static_cast<float>(src.x) * inv, v0 = static_cast<float>(src.y) * inv;
+    float u1 = static_cast<float>(src.x + src.w) * inv, v1 = static_cast<float>(src.y + src.h) * inv;
+    SDL_Color white{255, 255, 255, 255};
+    l.verts.push_back(SDL_Vertex{SDL_FPoint{x, 0.0f}, white, SDL_FPoint{u0, v0}});
+    l.verts.push_back(SDL_Vertex{SDL_FPoint{x1, 0.0f}, white, SDL_FPoint{u1, v0}});
+    l.verts.push_back(SDL_Vertex{SDL_FPoint{x1, y1}, white, SDL_FPoint{u1, v1}});
+    l.verts.push_back(SDL_Vertex{SDL_FPoint{x, y1}, white, SDL_FPoint{u0, v1}});
+}
+
+// Pen walk as SDL_ttf does it: kerning, then the glyph at pen + x_off. A
+// negative start shifts the whole line right, as TTF_RenderUTF8 would.
+bool build_layout(TextCache& tc, std::string_view s, TextLayout& l) {
+    TTF_Font* font = gg->ui_font;
+    const bool kerning = TTF_GetFontKerning(font) != 0;
+    l.verts.clear();
+    l.h = TTF_FontHeight(font);
+    int pen = 0, lo = 0, hi = 0;
+    std::uint32_t prev = 0;
+    for (std::size_t i = 0; i < s.size();) {
+        std::uint32_t cp = next_codepoint(s, i);
+        if (kerning && prev) pen += TTF_GetFontKerningSizeGlyphs32(font, prev, cp);
+        const Glyph* g = get_glyph(tc, cp);
+        if (!g) return false;
+        if (g->src.w > 0) {
+            int x0 = pen + g->x_off;
+            push_quad(l, static_cast<float>(x0), g->src);
+            lo = std::min(lo, x0);
+            hi = std::max(hi, x0 + g->src.w);
+        }
+        pen += g->advance;
+        hi = std::max(hi, pen);
+        prev = cp;
+    }
+    if (lo < 0)
+        for (auto& v : l.verts) v.position.x -= static_cast<float>(lo);
+    l.w = hi - lo;
+    return true;
+}
+
+TextLayout* get_layout(std::string_view s) {
+    if (!gg || !gg->renderer || !gg->ui_font) return nullptr;
+    TextCache& tc = gg->text;
+    if (auto it = tc.layouts.find(s); it != tc.layouts.end()) {
+        it->second.used = tc.frame;
+        return &it->second;
+    }
+    if (!ensure_atlas(tc)) return nullptr;
+    TextLayout l;
+    if (!build_layout(tc, s, l)) {
+        reset_atlas(tc);
+        if (!build_layout(tc, s, l)) return nullptr;
+    }
+    if (tc.layouts.size() >= LAYOUT_MAX) tc.layouts.clear();
+    l.used = tc.frame;
+    return &tc.layouts.emplace(std::string(s), std::move(l)).first->second;
+}
+
+} // namespace
+
+SDL_Rect draw_text(std::string_view s, int x, int y, SDL_Color col) {
+    TextLayout* l = get_layout(s);
+    if (!l) return SDL_Rect{x, y, 0, 0};
+    TextCache& tc = gg->text;
+    const std::size_t n = l->verts.size();
+    if (n > 0) {
+        tc.scratch.resize(n);
+        const float fx = static_cast<float>(x), fy = static_cast<float>(y);
+        for (std::size_t i = 0; i < n; ++i) {
+            SDL_Vertex v = l->verts[i];
+            v.position.x += fx;
+            v.position.y += fy;
+            v.color = col;
+            tc.scratch[i] = v;
+        }
+        const std::size_t quads = n / 4;
+        for (std::size_t q = tc.indices.size() / 6; q < quads; ++q) {
+            int b = static_cast<int>(q * 4);
+            tc.indices.insert(tc.indices.end(), {b, b + 1, b + 2, b, b + 2, b + 3});
+        }
+        SDL_RenderGeometry(gg->renderer, tc.atlas, tc.scratch.data(), static_cast<int>(n), tc.indices.data(),
+                           static_cast<int>(quads * 6));
+    }
+    return SDL_Rect{x, y, l->w, l->h};
+}
+
+SDL_Point measure_text(std::string_view s) {
+    TextLayout* l = get_layout(s);
+    return l ? SDL_Point{l->w, l->h} : SDL_Point{0, 0};
+}
+
+void text_end_frame() {
+    if (!gg) return;
+    TextCache& tc = gg->text;
+    tc.frame += 1;
+    if (tc.frame % SWEEP_EVERY != 0) return;
+    std::erase_if(tc.layouts, [&](const auto& kv) { return tc.frame - kv.second.used > LAYOUT_TTL; });
+}
+
+void clear_text_cache() {
+    if (!gg) return;
+    TextCache& tc = gg->text;
+    if (tc.atlas) {
+        SDL_DestroyTexture(tc.atlas);
+        tc.atlas = nullptr;
+    }
+    reset_atlas(tc);
+}
@@ -0,0 +1,54 @@
+// UI text.
+// Responsibility: draw gg->ui_font text as quads from one glyph atlas texture,
+// with each string's layout cached across frames.
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct Glyph {
+    SDL_Rect src{};  // in the atlas; w == 0 for blank glyphs
+    int x_off{0};    // quad x relative to the pen
+    int advance{0};
+};
+
+struct TextLayout {
+    std::vector<SDL_Vertex> verts; // 4 per quad, origin at the top left
+    int w{0};
+    int h{0};
+    std::uint32_t used{0}; // frame last drawn or measured
+};
+
+struct TextKeyHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+struct TextCache {
+    static constexpr int ATLAS = 1024;
+    SDL_Texture* atlas{nullptr};
+    std::unordered_map<std::uint32_t, Glyph> glyphs;
+    // Shelf packing: glyphs fill rows left to right
+    int shelf_x{0};
+    int shelf_y{0};
+    int shelf_h{0};
+    std::unordered_map<std::string, TextLayout, TextKeyHash, std::equal_to<>> layouts;
+    std::vector<SDL_Vertex> scratch; // tinted, positioned copy for one draw
+    std::vector<int> indices;        // 6 per quad, shared by every draw
+    std::uint32_t frame{0};
+};
+
+// Draw `s` with its top left at (x, y); returns where it landed. Same metrics
+// as TTF_RenderUTF8_Blended (height is the font height).
+SDL_Rect draw_text(std::string_view s, int x, int y, SDL_Color col);
+// Size of `s` as draw_text would draw it.
+SDL_Point measure_text(std::string_view s);
+// Age out layouts not drawn for a while; once per rendered frame.
+void text_end_frame();
+// Drop the atlas and layouts (before the renderer goes away).
+void clear_text_cache();
@@ -0,0 +1,87 @@
+// Tick host registry.
+// Responsibility: compact per-phase lists of the instances that opted into
+// Lua ticking, so the tick phases never scan inventories or all entities.
+#pragma once
+
+#include "lua/lua_defs.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum TickHostKind : std::uint8_t { TICK_HOST_DEAD = 0, TICK_HOST_GUN, TICK_HOST_ITEM, TICK_HOST_ENTITY, TICK_HOST_KIND_COUNT };
+
+struct TickHost {
+    VID vid{};   // entity, or gun/item instance
+    VID owner{}; // holder of a gun/item; unused for entities
+    int def_type{0};
+    float period{0.0f};
+    float acc{0.0f};
+    std::uint8_t kind{TICK_HOST_DEAD};
+};
+
+struct TickHosts {
+    std::array<std::vector<TickHost>, TICK_PHASE_COUNT> phases{};
+    // Where the next run of each phase starts, so a spilled budget resumes
+    // with the hosts that missed out instead of starving the list tail.
+    // Indexes the compacted list.
+    std::array<std::size_t, TICK_PHASE_COUNT> cursor{};
+
+    // Last known position of each host, by kind and VID slot id. Entries go
+    // stale when a host dies or moves; find() checks before trusting one.
+    struct Slot {
+        std::uint32_t index{0};
+        std::uint8_t phase{TICK_PHASE_COUNT}; // TICK_PHASE_COUNT: none
+    };
+    std::array<std::vector<Slot>, TICK_HOST_KIND_COUNT> slots{};
+
+    TickHost* find(std::uint8_t kind, VID vid) {
+        if (kind >= TICK_HOST_KIND_COUNT || vid.id >= slots[kind].size()) return nullptr;
+        const Slot s = slots[kind][vid.id];
+        if (s.phase >= TICK_PHASE_COUNT || s.index >= phases[s.phase].size()) return nullptr;
+        TickHost& h = phases[s.phase][s.index];
+        if (h.kind != kind || h.vid.id != vid.id || h.vid.version != vid.version) return nullptr;
+        return &h;
+    }
+    void add(TickPhase ph, const TickHost& h) {
+        remove(h.kind, h.vid); // one host per instance
+        note(ph, phases[ph].size(), h);
+        phases[ph].push_back(h);
+    }
+    // Marks only; the list is compacted when its phase next runs, so this is
+    // safe to call from inside a tick.
+    void remove(std::uint8_t kind, VID vid) {
+        if (TickHost* h = find(kind, vid)) h->kind = TICK_HOST_DEAD;
+    }
+    // Drops dead hosts from a phase. Returns where `pos` (an index before
+    // compaction) lands: the number of live hosts in front of it.
+    std::size_t compact(TickPhase ph, std::size_t pos) {
+        auto& list = phases[ph];
+        std::size_t live = 0, moved = 0;
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            if (i == pos) moved = live;
+            if (list[i].kind == TICK_HOST_DEAD) continue;
+            list[live] = list[i];
+            note(ph, live, list[live]);
+            ++live;
+        }
+        list.resize(live);
+        return moved;
+    }
+    void clear() {
+        for (auto& list : phases)
+            list.clear();
+        for (auto& s : slots)
+            s.clear();
+        cursor.fill(0);
+    }
+
+  private:
+    void note(TickPhase ph, std::size_t index, const TickHost& h) {
+        auto& s = slots[h.kind];
+        if (h.vid.id >= s.size()) s.resize(h.vid.id + 1);
+        s[h.vid.id] = Slot{static_cast<std::uint32_t>(index), ph};
+    }
+};
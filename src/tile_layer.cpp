@@ -0,0 +1,174 @@
+#include "tile_layer.hpp"
+#include "globals.hpp"
+#include "graphics.hpp"
+#include "state.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr int TILE_PX = static_cast<int>(TILE_SIZE); // chunk texels per tile
+constexpr int CHUNK = static_cast<int>(Stage::CHUNK);
+
+enum TileKind { TK_FLOOR = -1, TK_WALL, TK_VOID, TK_START, TK_EXIT, TK_COUNT };
+
+constexpr SDL_Color KIND_COLOUR[TK_COUNT] = {
+    {90, 90, 90, 255},  // wall
+    {70, 90, 160, 255}, // void/water
+    {80, 220, 90, 255}, // start
+    {240, 220, 80, 255} // exit
+};
+
+// Floor is left transparent so the clear colour shows through.
+int tile_kind(int x, int y) {
+    if (x == ss->start_tile.x && y == ss->start_tile.y) return TK_START;
+    if (x == ss->exit_tile.x && y == ss->exit_tile.y) return TK_EXIT;
+    const TileProps& t = ss->stage.at(x, y);
+    if (t.blocks_entities() && !t.blocks_projectiles()) return TK_VOID;
+    if (t.blocks_entities() || t.blocks_projectiles()) return TK_WALL;
+    return TK_FLOOR;
+}
+
+// Tiles [x0, x1) x [y0, y1) of a chunk (edge chunks are cut to the stage)
+struct TileSpan {
+    int x0, y0, x1, y1;
+};
+
+TileSpan chunk_span(int cx, int cy) {
+    const int w = static_cast<int>(ss->stage.get_width()), h = static_cast<int>(ss->stage.get_height());
+    return TileSpan{cx * CHUNK, cy * CHUNK, std::min((cx + 1) * CHUNK, w), std::min((cy + 1) * CHUNK, h)};
+}
+
+// One SDL_RenderFillRects per tile kind.
+template <class ToRect>
+void fill_tiles(SDL_Renderer* r, const TileSpan& s, ToRect to_rect) {
+    static std::vector<SDL_Rect> rects[TK_COUNT];
+    for (auto& v : rects) v.clear();
+    for (int y = s.y0; y < s.y1; ++y)
+        for (int x = s.x0; x < s.x1; ++x)
+            if (int k = tile_kind(x, y); k != TK_FLOOR) rects[k].push_back(to_rect(x, y));
+    for (int k = 0; k < TK_COUNT; ++k) {
+        if (rects[k].empty()) continue;
+        const SDL_Color& c = KIND_COLOUR[k];
+        SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRects(r, rects[k].data(), static_cast<int>(rects[k].size()));
+    }
+}
+
+bool build_chunk(SDL_Renderer* r, TileChunk& c, int cx, int cy) {
+    const TileSpan s = chunk_span(cx, cy);
+    if (!c.tex) {
+        c.tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, (s.x1 - s.x0) * TILE_PX,
+                                  (s.y1 - s.y0) * TILE_PX);
+        if (!c.tex) {
+            std::fprintf(stderr, "[gfx] tile chunk target failed: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(c.tex, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(c.tex, SDL_ScaleModeNearest); // keep tile edges hard when zoomed
+    }
+    SDL_Texture* prev = SDL_GetRenderTarget(r);
+    SDL_BlendMode prev_blend = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(r, &prev_blend);
+    if (SDL_SetRenderTarget(r, c.tex) != 0) {
+        std::fprintf(stderr, "[gfx] tile chunk target failed: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+    SDL_RenderClear(r);
+    fill_tiles(r, s, [&](int x, int y) {
+        return SDL_Rect{(x - s.x0) * TILE_PX, (y - s.y0) * TILE_PX, TILE_PX, TILE_PX};
+    });
+    SDL_SetRenderTarget(r, prev);
+    SDL_SetRenderDrawBlendMode(r, prev_blend);
+    c.rev = ss->stage.chunk_rev(static_cast<std::uint32_t>(cx), static_cast<std::uint32_t>(cy));
+    c.valid = true;
+    gg->tiles.rebuilds += 1;
+    return true;
+}
+
+// Match the chunk grid to the stage; a regenerated room redraws everything.
+void sync_chunks(TileLayer& L) {
+    const Stage& st = ss->stage;
+    if (L.stage_w != st.get_width() || L.stage_h != st.get_height()) {
+        clear_tile_layer();
+        L.stage_w = st.get_width();
+        L.stage_h = st.get_height();
+        L.chunks.assign(static_cast<std::size_t>(st.get_chunks_w()) * st.get_chunks_h(), TileChunk{});
+    } else if (ss->rebuild_render_texture) {
+        invalidate_tile_layer();
+    }
+    ss->rebuild_render_texture = false;
+}
+
+} // namespace
+
+void draw_tile_layer(int width, int height) {
+    SDL_Renderer* r = gg->renderer;
+    if (!r) return;
+    TileLayer& L = gg->tiles;
+    sync_chunks(L);
+    if (!L.direct && !SDL_RenderTargetSupported(r)) L.direct = true;
+
+    const float scale = TILE_SIZE * gg->play_cam.zoom;
+    const glm::vec2 cam = gg->play_cam.pos;
+    auto to_screen_x = [&](int tx) {
+        return static_cast<int>(std::floor((static_cast<float>(tx) - cam.x) * scale + static_cast<float>(width) * 0.5f));
+    };
+    auto to_screen_y = [&](int ty) {
+        return static_cast<int>(std::floor((static_cast<float>(ty) - cam.y) * scale + static_cast<float>(height) * 0.5f));
+    };
+    // Visible tiles, then the chunks holding them
+    const int sw = static_cast<int>(L.stage_w), sh = static_cast<int>(L.stage_h);
+    const float half_w = static_cast<float>(width) * 0.5f / scale, half_h = static_cast<float>(height) * 0.5f / scale;
+    const int tx0 = static_cast<int>(std::floor(cam.x - half_w)), tx1 = static_cast<int>(std::floor(cam.x + half_w));
+    const int ty0 = static_cast<int>(std::floor(cam.y - half_h)), ty1 = static_cast<int>(std::floor(cam.y + half_h));
+    const int chunks_w = (sw + CHUNK - 1) / CHUNK, chunks_h = (sh + CHUNK - 1) / CHUNK;
+    const auto total = static_cast<std::uint32_t>(chunks_w * chunks_h);
+    if (tx1 < 0 || ty1 < 0 || tx0 >= sw || ty0 >= sh) {
+        gg->cull.culled[CULL_TILE_CHUNKS] += total;
+        return;
+    }
+    const int cx0 = std::max(tx0, 0) / CHUNK, cx1 = std::min(tx1, sw - 1) / CHUNK;
+    const int cy0 = std::max(ty0, 0) / CHUNK, cy1 = std::min(ty1, sh - 1) / CHUNK;
+    const auto visible = static_cast<std::uint32_t>((cx1 - cx0 + 1) * (cy1 - cy0 + 1));
+    gg->cull.drawn[CULL_TILE_CHUNKS] += visible;
+    gg->cull.culled[CULL_TILE_CHUNKS] += total - visible;
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const TileSpan s = chunk_span(cx, cy);
+            if (!L.direct) {
+                TileChunk& c = L.chunks[static_cast<std::size_t>(cy * chunks_w + cx)];
+                const std::uint32_t rev = ss->stage.chunk_rev(static_cast<std::uint32_t>(cx), static_cast<std::uint32_t>(cy));
+                if ((c.valid && c.rev == rev) || build_chunk(r, c, cx, cy)) {
+                    // Both corners floored so neighbouring chunks meet without seams
+                    const int x0 = to_screen_x(s.x0), y0 = to_screen_y(s.y0);
+                    SDL_Rect dst{x0, y0, to_screen_x(s.x1) - x0, to_screen_y(s.y1) - y0};
+                    SDL_RenderCopy(r, c.tex, nullptr, &dst);
+                    continue;
+                }
+                L.direct = true; // no usable render target; stay on the fallback
+            }
+            const int px = static_cast<int>(std::ceil(scale));
+            fill_tiles(r, s, [&](int x, int y) { return SDL_Rect{to_screen_x(x), to_screen_y(y), px, px}; });
+        }
+    }
+}
+
+void invalidate_tile_layer() {
+    if (!gg) return;
+    for (TileChunk& c : gg->tiles.chunks) c.valid = false;
+}
+
+void clear_tile_layer() {
+    if (!gg) return;
+    TileLayer& L = gg->tiles;
+    for (TileChunk& c : L.chunks)
+        if (c.tex) SDL_DestroyTexture(c.tex);
+    L.chunks.clear();
+    L.stage_w = L.stage_h = 0;
+}
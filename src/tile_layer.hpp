@@ -0,0 +1,30 @@
+// Tile layer.
+// Responsibility: keep the stage's tiles pre-rendered into one render target
+// per Stage chunk, redraw a chunk only when its revision changes or the room
+// is regenerated, and blit the visible chunks with the play camera.
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+struct TileChunk {
+    SDL_Texture* tex{nullptr};
+    std::uint32_t rev{0}; // Stage::chunk_rev it was drawn at
+    bool valid{false};
+};
+
+struct TileLayer {
+    std::vector<TileChunk> chunks; // row-major over the Stage chunk grid
+    std::uint32_t stage_w{0};      // stage size the chunks were made for
+    std::uint32_t stage_h{0};
+    bool direct{false}; // no render targets; tiles are filled every frame
+    std::uint64_t rebuilds{0};
+};
+
+// Draw the play stage's tiles for an output of `width` x `height`.
+void draw_tile_layer(int width, int height);
+// Redraw every chunk on next use (render targets lost).
+void invalidate_tile_layer();
+// Destroy the chunk textures.
+void clear_tile_layer();
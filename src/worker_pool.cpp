@@ -0,0 +1,74 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+void WorkerPool::set_threads(std::size_t threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads == this->threads())
+        return;
+    stop_workers();
+    // Hand each worker the current generation; reading it on the new thread
+    // could race with the next run() and miss that batch
+    std::uint64_t gen = generation;
+    for (std::size_t i = 1; i < threads; ++i)
+        workers.emplace_back([this, gen] { worker_loop(gen); });
+}
+
+void WorkerPool::run(std::size_t tasks, const std::function<void(std::size_t)>& fn) {
+    if (workers.empty() || tasks <= 1) {
+        for (std::size_t t = 0; t < tasks; ++t)
+            fn(t);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        job = &fn;
+        job_tasks = tasks;
+        next_task.store(0, std::memory_order_relaxed);
+        busy = workers.size();
+        ++generation;
+    }
+    cv_start.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lk(mu);
+    cv_done.wait(lk, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::worker_loop(std::uint64_t seen) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(mu);
+            cv_start.wait(lk, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        drain();
+        std::lock_guard<std::mutex> lk(mu);
+        if (--busy == 0)
+            cv_done.notify_one();
+    }
+}
+
+void WorkerPool::drain() {
+    for (;;) {
+        std::size_t t = next_task.fetch_add(1, std::memory_order_relaxed);
+        if (t >= job_tasks)
+            return;
+        (*job)(t);
+    }
+}
+
+void WorkerPool::stop_workers() {
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        stopping = true;
+    }
+    cv_start.notify_all();
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+    stopping = false;
+}
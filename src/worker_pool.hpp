@@ -0,0 +1,51 @@
+// Persistent worker threads for data-parallel loops.
+// Responsibility: run a batch of independent tasks across a fixed set of
+// threads; the calling thread takes part and run() returns when all are done.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct WorkerPool {
+  public:
+    explicit WorkerPool(std::size_t threads = 1) {
+        set_threads(threads);
+    }
+    ~WorkerPool() {
+        stop_workers();
+    }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Total threads including the caller; 0 => hardware concurrency.
+    void set_threads(std::size_t threads);
+    std::size_t threads() const {
+        return workers.size() + 1;
+    }
+
+    // Calls fn(task) once for every task in [0, tasks), in any order and on
+    // any thread. Tasks must not touch each other's data.
+    void run(std::size_t tasks, const std::function<void(std::size_t)>& fn);
+
+  private:
+    void worker_loop(std::uint64_t seen);
+    void drain();
+    void stop_workers();
+
+    std::vector<std::thread> workers;
+    std::mutex mu;
+    std::condition_variable cv_start;
+    std::condition_variable cv_done;
+    const std::function<void(std::size_t)>* job{nullptr};
+    std::size_t job_tasks{0};
+    std::atomic<std::size_t> next_task{0};
+    std::size_t busy{0};          // workers still inside the current batch
+    std::uint64_t generation{0};  // bumped per batch; wakes the workers
+    bool stopping{false};
+};